@@ -0,0 +1,36 @@
+// ============================================================================
+// BENCHMARKS - SIMULACIÓN HIL
+// ============================================================================
+
+#include <benchmark/benchmark.h>
+#include "hil.h"
+
+using namespace std;
+
+// Un paso de la planta por iteración con entrada senoidal
+static void BM_PlantaG_actualizar(benchmark::State& estado) {
+    PlantaG planta;
+    double t = 0.0;
+    for (auto _ : estado) {
+        double u = GeneradorSenal::generar(GeneradorSenal::SENOIDAL, t);
+        benchmark::DoNotOptimize(planta.actualizar(u));
+        t += TAU_S;
+    }
+    estado.SetItemsProcessed(estado.iterations());
+}
+BENCHMARK(BM_PlantaG_actualizar);
+
+// Un paso del derivador por iteración siguiendo una senoidal
+static void BM_DerivadorSuperior_actualizar(benchmark::State& estado) {
+    DerivadorSuperior derivador;
+    double t = 0.0;
+    for (auto _ : estado) {
+        derivador.actualizar(GeneradorSenal::generar(GeneradorSenal::SENOIDAL, t));
+        benchmark::DoNotOptimize(derivador.obtenerZ1());
+        t += TAU_S;
+    }
+    estado.SetItemsProcessed(estado.iterations());
+}
+BENCHMARK(BM_DerivadorSuperior_actualizar);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,44 @@
+// ============================================================================
+// BENCHMARKS - RESOLVEDOR DE 8-PUZZLE
+// ============================================================================
+
+#include <benchmark/benchmark.h>
+#include "puzzle.h"
+
+using namespace std;
+
+// Tableros solubles de dificultad creciente (longitud de la solución óptima)
+static const State TABLEROS[] = {
+    "123456708",   // 1 movimiento
+    "123405786",   // 2 movimientos
+    "413726580",   // 8 movimientos
+    "867254301",   // 31 movimientos (máximo del 8-puzzle)
+};
+static const int MOVIMIENTOS[] = {1, 2, 8, 31};
+
+static void BM_solvePuzzle(benchmark::State& estado) {
+    const State& inicio = TABLEROS[estado.range(0)];
+    for (auto _ : estado) {
+        benchmark::DoNotOptimize(solvePuzzle(inicio, false));
+    }
+    estado.SetLabel(to_string(MOVIMIENTOS[estado.range(0)]) + " movimientos");
+}
+BENCHMARK(BM_solvePuzzle)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+static void BM_heuristic(benchmark::State& estado) {
+    const State& tablero = TABLEROS[3];
+    for (auto _ : estado) {
+        benchmark::DoNotOptimize(heuristic(tablero));
+    }
+}
+BENCHMARK(BM_heuristic);
+
+static void BM_getNeighbors(benchmark::State& estado) {
+    const State& tablero = TABLEROS[2];
+    for (auto _ : estado) {
+        benchmark::DoNotOptimize(getNeighbors(tablero));
+    }
+}
+BENCHMARK(BM_getNeighbors);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,94 @@
+// ============================================================================
+// BENCHMARKS - RED NEURONAL
+// ============================================================================
+
+#include <benchmark/benchmark.h>
+#include "red_neuronal.h"
+#include "datos.h"
+
+using namespace std;
+
+// Glifo 7x5 del dígito 8, para no depender de digitos.txt
+static vector<double> glifo_ocho() {
+    const char* filas[FILAS_DIGITO] = {"01110", "10001", "10001", "01110", "10001", "10001", "01110"};
+    vector<double> glifo;
+    for (const char* fila : filas) {
+        for (int c = 0; c < COLS_DIGITO; ++c) glifo.push_back(fila[c] == '1' ? 1.0 : 0.0);
+    }
+    return glifo;
+}
+
+static void BM_RedNeuronal_forward(benchmark::State& estado) {
+    RedNeuronal red;
+    vector<double> entrada = glifo_ocho();
+    for (auto _ : estado) {
+        benchmark::DoNotOptimize(red.forward(entrada));
+    }
+    estado.SetItemsProcessed(estado.iterations());
+}
+BENCHMARK(BM_RedNeuronal_forward);
+
+// backward necesita las activaciones del forward previo: se mide el par
+// y por separado solo el forward, la diferencia es el costo de backward
+static void BM_RedNeuronal_forward_backward(benchmark::State& estado) {
+    RedNeuronal red;
+    ConfigEntrenamiento config;
+    config.optimizador = static_cast<TipoOptimizador>(estado.range(0));
+    red.configurar(config);
+    vector<double> entrada = glifo_ocho();
+    vector<double> objetivo = clases_a_vector(obtener_clases(8));
+    for (auto _ : estado) {
+        benchmark::DoNotOptimize(red.forward(entrada));
+        red.backward(objetivo);
+    }
+    estado.SetLabel(nombre_optimizador(config.optimizador));
+    estado.SetItemsProcessed(estado.iterations());
+}
+BENCHMARK(BM_RedNeuronal_forward_backward)->Arg(OPT_SGD)->Arg(OPT_MOMENTUM)->Arg(OPT_ADAM);
+
+// Imagen de 28x28 con tres trazos rectos de dos píxeles de grosor
+// (~10% de píxeles encendidos), para comparar la ruta densa con la binaria
+static vector<double> imagen_trazos(unsigned semilla) {
+    const int lado = 28;
+    mt19937 generador(semilla);
+    uniform_int_distribution<int> coordenada(0, lado - 2);
+    vector<double> imagen(lado * lado, 0.0);
+    for (int t = 0; t < 3; ++t) {
+        int x0 = coordenada(generador), y0 = coordenada(generador);
+        int x1 = coordenada(generador), y1 = coordenada(generador);
+        for (int paso = 0; paso <= 40; ++paso) {
+            int x = x0 + (x1 - x0) * paso / 40, y = y0 + (y1 - y0) * paso / 40;
+            imagen[y * lado + x] = imagen[y * lado + x + 1] = 1.0;
+        }
+    }
+    return imagen;
+}
+
+// Argumentos: optimizador y ruta (0 = densa, 1 = bits)
+static void BM_RedNeuronal_entrenamiento_28x28(benchmark::State& estado) {
+    RedNeuronal red(28 * 28, 64, SALIDAS);
+    ConfigEntrenamiento config;
+    config.optimizador = static_cast<TipoOptimizador>(estado.range(0));
+    red.configurar(config);
+    bool bits = estado.range(1) != 0;
+    vector<double> entrada = imagen_trazos(1);
+    EntradaBits entrada_bits = empaquetar_entrada(entrada);
+    vector<double> objetivo = clases_a_vector(obtener_clases(7));
+    for (auto _ : estado) {
+        if (bits) {
+            benchmark::DoNotOptimize(red.forward_bits(entrada_bits));
+            red.backward_bits(objetivo);
+        } else {
+            benchmark::DoNotOptimize(red.forward(entrada));
+            red.backward(objetivo);
+        }
+    }
+    estado.SetLabel(nombre_optimizador(config.optimizador) + (bits ? " bits" : " densa"));
+    estado.SetItemsProcessed(estado.iterations());
+}
+BENCHMARK(BM_RedNeuronal_entrenamiento_28x28)
+    ->Args({OPT_SGD, 0})->Args({OPT_SGD, 1})
+    ->Args({OPT_MOMENTUM, 0})->Args({OPT_MOMENTUM, 1})
+    ->Args({OPT_ADAM, 0})->Args({OPT_ADAM, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,553 @@
+// ============================================================================
+// CARGA DE TRABAJO FIJA - REGRESIONES DE RENDIMIENTO Y PGO
+// ============================================================================
+// Ejecuta un corpus reproducible sobre los tres ejercicios y mide, por
+// carga, el tiempo de pared y (en Linux) contadores de hardware con
+// perf_event_open: ciclos, instrucciones y fallos de caché.
+//
+//   carga_trabajo [--corpus dir] [--linea-base archivo] [--actualizar-linea-base]
+//                 [--tolerancia 0.10] [--repeticiones 5] [--solo prefijo]
+//                 [--muestras-hil N] [--glifos N] [--generar-glifos archivo.glb]
+//
+// Cada carga se ejecuta --repeticiones veces y se toma el mínimo (el ruido
+// del sistema solo suma tiempo). Con --linea-base compara contra el
+// archivo (o lo crea si no existe) y termina con código 1 si alguna carga
+// es más lenta que la tolerancia. La línea base guarda el tamaño de las
+// cargas; no se compara contra una ejecución de otro tamaño. Con --solo
+// no se crea ni se actualiza la línea base (le faltarían cargas).
+// La misma ejecución sirve para entrenar los perfiles de PGO.
+// ============================================================================
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "puzzle.h"
+#include "hil.h"
+#include "red_neuronal.h"
+#include "inferencia.h"
+#include "datos.h"
+#include "instrumentacion.h"
+#include "argumentos.h"
+
+using namespace std;
+
+#ifndef TALLER_CORPUS_DIR
+#define TALLER_CORPUS_DIR "corpus"
+#endif
+
+// ==================== CONTADORES DE HARDWARE ====================
+// Grupo de perf_event_open (ciclos como líder) restringido al espacio de
+// usuario del proceso actual, así funciona con perf_event_paranoid = 2.
+// Si el núcleo no lo permite (contenedores, otros sistemas) los contadores
+// quedan como no disponibles y solo se mide el tiempo.
+struct Medicion {
+    double segundos = 0.0;
+    bool hay_contadores = false;
+    uint64_t ciclos = 0;
+    uint64_t instrucciones = 0;
+    uint64_t fallos_cache = 0;
+};
+
+class ContadoresHardware {
+private:
+#ifdef __linux__
+    int descriptores[3];
+
+    static int abrir(uint64_t config, int lider) {
+        perf_event_attr atributos;
+        memset(&atributos, 0, sizeof(atributos));
+        atributos.type = PERF_TYPE_HARDWARE;
+        atributos.size = sizeof(atributos);
+        atributos.config = config;
+        atributos.disabled = lider < 0 ? 1 : 0;
+        atributos.exclude_kernel = 1;
+        atributos.exclude_hv = 1;
+        atributos.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(__NR_perf_event_open, &atributos, 0, -1, lider, 0));
+    }
+#endif
+
+public:
+    ContadoresHardware() {
+#ifdef __linux__
+        descriptores[0] = abrir(PERF_COUNT_HW_CPU_CYCLES, -1);
+        descriptores[1] = descriptores[0] >= 0 ? abrir(PERF_COUNT_HW_INSTRUCTIONS, descriptores[0]) : -1;
+        descriptores[2] = descriptores[0] >= 0 ? abrir(PERF_COUNT_HW_CACHE_MISSES, descriptores[0]) : -1;
+        if (!disponibles()) cerrar();
+#endif
+    }
+
+    ContadoresHardware(const ContadoresHardware&) = delete;
+    ContadoresHardware& operator=(const ContadoresHardware&) = delete;
+
+    ~ContadoresHardware() { cerrar(); }
+
+    bool disponibles() const {
+#ifdef __linux__
+        return descriptores[0] >= 0 && descriptores[1] >= 0 && descriptores[2] >= 0;
+#else
+        return false;
+#endif
+    }
+
+    void cerrar() {
+#ifdef __linux__
+        for (int& fd : descriptores) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+#endif
+    }
+
+    void iniciar() {
+#ifdef __linux__
+        if (!disponibles()) return;
+        ioctl(descriptores[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(descriptores[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void detener(Medicion& medicion) {
+#ifdef __linux__
+        if (!disponibles()) return;
+        ioctl(descriptores[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t valores[4] = {};   // nr, ciclos, instrucciones, fallos
+        if (read(descriptores[0], valores, sizeof(valores)) == static_cast<ssize_t>(sizeof(valores))
+            && valores[0] == 3) {
+            medicion.hay_contadores = true;
+            medicion.ciclos = valores[1];
+            medicion.instrucciones = valores[2];
+            medicion.fallos_cache = valores[3];
+        }
+#else
+        (void)medicion;
+#endif
+    }
+};
+
+// ==================== CORPUS ====================
+// Tableros del 8-puzzle por profundidad (0-31), leídos del corpus
+struct TableroCorpus {
+    int profundidad;
+    State tablero;
+};
+
+vector<TableroCorpus> cargar_tableros(const string& nombre_archivo) {
+    ifstream archivo(nombre_archivo);
+    if (!archivo.is_open()) {
+        cerr << "Error: No se pudo abrir el corpus " << nombre_archivo << endl;
+        return {};
+    }
+    vector<TableroCorpus> tableros;
+    string linea;
+    while (getline(archivo, linea)) {
+        if (linea.empty() || linea[0] == '#') continue;
+        istringstream campos(linea);
+        TableroCorpus t;
+        if (campos >> t.profundidad >> t.tablero) tableros.push_back(t);
+    }
+    return tableros;
+}
+
+// Prototipos 7x5 de los dígitos 0-9 para el conjunto sintético
+const char* const PROTOTIPOS[10][FILAS_DIGITO] = {
+    {"01110", "10001", "10011", "10101", "11001", "10001", "01110"},
+    {"00100", "01100", "00100", "00100", "00100", "00100", "01110"},
+    {"01110", "10001", "00001", "00010", "00100", "01000", "11111"},
+    {"11111", "00010", "00100", "00010", "00001", "10001", "01110"},
+    {"00010", "00110", "01010", "10010", "11111", "00010", "00010"},
+    {"11111", "10000", "11110", "00001", "00001", "10001", "01110"},
+    {"00110", "01000", "10000", "11110", "10001", "10001", "01110"},
+    {"11111", "00001", "00010", "00100", "01000", "01000", "01000"},
+    {"01110", "10001", "10001", "01110", "10001", "10001", "01110"},
+    {"01110", "10001", "10001", "01111", "00001", "00010", "01100"},
+};
+
+// Glifo i = prototipo (i % 10) con cada píxel invertido con probabilidad
+// 'ruido'. Misma semilla, mismo conjunto en cualquier máquina.
+void generar_glifos(size_t cantidad, double ruido, unsigned semilla,
+                    vector<vector<double>>& glifos, vector<vector<double>>& objetivos) {
+    mt19937 generador(semilla);
+    bernoulli_distribution invertir(ruido);
+    vector<vector<double>> objetivo_por_digito;
+    for (int d = 0; d < 10; ++d) objetivo_por_digito.push_back(clases_a_vector(obtener_clases(d)));
+
+    glifos.assign(cantidad, vector<double>(ENTRADAS));
+    objetivos.resize(cantidad);
+    for (size_t i = 0; i < cantidad; ++i) {
+        int digito = static_cast<int>(i % 10);
+        for (int f = 0; f < FILAS_DIGITO; ++f) {
+            for (int c = 0; c < COLS_DIGITO; ++c) {
+                bool activo = PROTOTIPOS[digito][f][c] == '1';
+                if (invertir(generador)) activo = !activo;
+                glifos[i][f * COLS_DIGITO + c] = activo ? 1.0 : 0.0;
+            }
+        }
+        objetivos[i] = objetivo_por_digito[digito];
+    }
+}
+
+// Escribe el conjunto sintético en el formato binario .glb de eje_3
+bool guardar_glifos(const string& nombre_archivo, const vector<vector<double>>& glifos) {
+    ofstream salida(nombre_archivo, ios::binary | ios::trunc);
+    if (!salida.is_open()) {
+        cerr << "Error: No se pudo crear el archivo " << nombre_archivo << endl;
+        return false;
+    }
+    CabeceraGlifos cabecera = {};
+    copy(begin(MAGIA_GLIFOS), end(MAGIA_GLIFOS), cabecera.magia);
+    cabecera.filas = FILAS_DIGITO;
+    cabecera.columnas = COLS_DIGITO;
+    cabecera.cantidad = glifos.size();
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+
+    vector<char> registro(1 + (ENTRADAS + 7) / 8);
+    for (size_t i = 0; i < glifos.size(); ++i) {
+        fill(registro.begin(), registro.end(), 0);
+        registro[0] = static_cast<char>(i % 10);
+        for (int p = 0; p < ENTRADAS; ++p) {
+            if (glifos[i][p] > 0.5) registro[1 + p / 8] |= static_cast<char>(1u << (p % 8));
+        }
+        salida.write(registro.data(), static_cast<streamsize>(registro.size()));
+    }
+    return static_cast<bool>(salida);
+}
+
+// ==================== LÍNEA BASE ====================
+// Formato de texto: una línea "parametros muestras_hil glifos" con el
+// tamaño de las cargas y una por carga "nombre segundos ciclos
+// instrucciones fallos_cache" (contadores en 0 si no estaban disponibles
+// al guardarla)
+struct ParametrosCarga {
+    long muestras_hil = 0;
+    size_t glifos = 0;
+    
+    bool operator==(const ParametrosCarga& otro) const {
+        return muestras_hil == otro.muestras_hil && glifos == otro.glifos;
+    }
+};
+
+map<string, Medicion> leer_linea_base(const string& nombre_archivo, ParametrosCarga& parametros) {
+    map<string, Medicion> linea_base;
+    ifstream archivo(nombre_archivo);
+    string linea;
+    while (getline(archivo, linea)) {
+        if (linea.empty() || linea[0] == '#') continue;
+        istringstream campos(linea);
+        string nombre;
+        Medicion m;
+        if (linea.compare(0, 11, "parametros ") == 0) {
+            campos >> nombre >> parametros.muestras_hil >> parametros.glifos;
+        } else if (campos >> nombre >> m.segundos >> m.ciclos >> m.instrucciones >> m.fallos_cache) {
+            m.hay_contadores = m.instrucciones > 0;
+            linea_base[nombre] = m;
+        }
+    }
+    return linea_base;
+}
+
+bool guardar_linea_base(const string& nombre_archivo, const ParametrosCarga& parametros,
+                        const vector<pair<string, Medicion>>& mediciones) {
+    ofstream archivo(nombre_archivo, ios::trunc);
+    if (!archivo.is_open()) {
+        cerr << "Error: No se pudo crear la línea base " << nombre_archivo << endl;
+        return false;
+    }
+    archivo << "# parametros muestras_hil glifos\n";
+    archivo << "parametros " << parametros.muestras_hil << " " << parametros.glifos << "\n";
+    archivo << "# nombre segundos ciclos instrucciones fallos_cache\n";
+    for (const auto& [nombre, m] : mediciones) {
+        archivo << nombre << " " << setprecision(9) << m.segundos << " " << m.ciclos << " "
+                << m.instrucciones << " " << m.fallos_cache << "\n";
+    }
+    return static_cast<bool>(archivo);
+}
+
+// ==================== CARGAS ====================
+struct Carga {
+    string nombre;
+    function<double()> ejecutar;   // Devuelve una suma de control
+};
+
+struct Opciones {
+    string corpus = TALLER_CORPUS_DIR;
+    string linea_base;
+    bool actualizar_linea_base = false;
+    double tolerancia = 0.10;
+    int repeticiones = 5;            // Se toma el mínimo de las repeticiones
+    string solo;
+    long muestras_hil = 10000000;   // 10^7 muestras por tipo de señal
+    size_t glifos = 200000;
+    string generar_glifos;
+};
+
+vector<Carga> preparar_cargas(const Opciones& opciones) {
+    vector<Carga> cargas;
+
+    // 8-puzzle: tres bandas de profundidad; las superficiales se repiten
+    // para que su tiempo sea medible
+    vector<TableroCorpus> tableros = cargar_tableros(opciones.corpus + "/tableros_8puzzle.txt");
+    struct Banda { string nombre; int desde, hasta, repeticiones; };
+    const Banda bandas[] = {
+        {"puzzle_profundidad_00_15", 0, 15, 200},
+        {"puzzle_profundidad_16_23", 16, 23, 5},
+        {"puzzle_profundidad_24_31", 24, 31, 1},
+    };
+    for (const Banda& banda : bandas) {
+        vector<State> seleccion;
+        for (const TableroCorpus& t : tableros) {
+            if (t.profundidad >= banda.desde && t.profundidad <= banda.hasta) seleccion.push_back(t.tablero);
+        }
+        if (seleccion.empty()) continue;
+        cargas.push_back({banda.nombre, [seleccion, banda] {
+            double resueltos = 0;
+            for (int r = 0; r < banda.repeticiones; ++r) {
+                for (const State& tablero : seleccion) resueltos += solvePuzzle(tablero, false) ? 1 : 0;
+            }
+            return resueltos;
+        }});
+    }
+
+    // HIL: el lazo de simulación completo (señal, derivador y planta) sin
+    // escribir el CSV, para medir solo el cómputo
+    const pair<GeneradorSenal::TipoSenal, string> senales[] = {
+        {GeneradorSenal::ESCALON, "hil_escalon"},
+        {GeneradorSenal::RAMPA, "hil_rampa"},
+        {GeneradorSenal::SENOIDAL, "hil_senoidal"},
+    };
+    long muestras = opciones.muestras_hil;
+    for (const auto& [tipo, nombre] : senales) {
+        GeneradorSenal::TipoSenal tipo_senal = tipo;
+        cargas.push_back({nombre, [tipo_senal, muestras] {
+            PlantaG planta;
+            DerivadorSuperior derivador;
+            double tiempo = 0.0, suma = 0.0;
+            for (long k = 0; k < muestras; ++k) {
+                double referencia = GeneradorSenal::generar(tipo_senal, tiempo);
+                derivador.actualizar(referencia);
+                suma += planta.actualizar(referencia) + derivador.obtenerZ1();
+                tiempo += TAU_S;
+            }
+            return suma;
+        }});
+    }
+
+    // Red neuronal: conjunto sintético grande, entrenamiento corto e
+    // inferencia en las rutas double, float32 en bits e int8
+    auto glifos = make_shared<vector<vector<double>>>();
+    auto objetivos = make_shared<vector<vector<double>>>();
+    generar_glifos(opciones.glifos, 0.03, 2025, *glifos, *objetivos);
+    auto red = make_shared<RedNeuronal>();
+
+    cargas.push_back({"red_entrenamiento_sgd", [glifos, objetivos, red] {
+        ConfigEntrenamiento config;
+        config.epocas = 2;
+        config.mostrar_progreso = false;
+        *red = RedNeuronal();
+        red->configurar(config);
+        return red->entrenar(*glifos, *objetivos).error_final;
+    }});
+    cargas.push_back({"red_inferencia_double", [glifos, red] {
+        double suma = 0.0;
+        for (const vector<double>& g : *glifos) suma += red->predecir(g)[0];
+        return suma;
+    }});
+    cargas.push_back({"red_inferencia_f32_bits", [glifos, red] {
+        RedNeuronalF32 red_f32(*red);
+        double suma = 0.0;
+        for (const vector<double>& g : *glifos) suma += red_f32.predecir_bits(empaquetar_entrada(g))[0];
+        return suma;
+    }});
+    cargas.push_back({"red_inferencia_int8", [glifos, red] {
+        RedNeuronalInt8 red_int8(*red);
+        double suma = 0.0;
+        for (const vector<double>& g : *glifos) suma += red_int8.predecir(g)[0];
+        return suma;
+    }});
+
+    if (!opciones.generar_glifos.empty() && guardar_glifos(opciones.generar_glifos, *glifos)) {
+        cout << "Conjunto sintético de " << glifos->size() << " glifos guardado en "
+             << opciones.generar_glifos << "\n";
+    }
+    return cargas;
+}
+
+// ==================== FUNCIÓN PRINCIPAL ====================
+int main(int argc, char* argv[]) {
+    Argumentos argumentos({
+        {"corpus", "", true, "Directorio del corpus (por defecto benchmarks/corpus)"},
+        {"linea-base", "", true, "Archivo de línea base: compara contra él o lo crea"},
+        {"actualizar-linea-base", "", false, "Sobrescribe la línea base con esta ejecución"},
+        {"tolerancia", "", true, "Empeoramiento admitido antes de marcar regresión (por defecto 0.10)"},
+        {"repeticiones", "", true, "Repeticiones por carga; se toma el mínimo (por defecto 5)"},
+        {"solo", "", true, "Ejecuta solo las cargas cuyo nombre empieza por este prefijo"},
+        {"muestras-hil", "", true, "Muestras por señal de las cargas HIL (por defecto 10000000)"},
+        {"glifos", "", true, "Glifos sintéticos de las cargas de la red (por defecto 200000)"},
+        {"generar-glifos", "", true, "Guarda el conjunto sintético en este archivo .glb"},
+    });
+    if (!argumentos.analizar(argc, argv)) return 1;
+    if (argumentos.bandera("ayuda")) {
+        argumentos.mostrar_ayuda("carga_trabajo", "Carga de trabajo fija: mide cada carga y la compara con la línea base.");
+        return 0;
+    }
+
+    Opciones opciones;
+    int muestras_hil = static_cast<int>(opciones.muestras_hil);
+    int glifos = static_cast<int>(opciones.glifos);
+    opciones.corpus = argumentos.obtener("corpus", opciones.corpus);
+    opciones.linea_base = argumentos.obtener("linea-base");
+    opciones.actualizar_linea_base = argumentos.bandera("actualizar-linea-base");
+    opciones.solo = argumentos.obtener("solo");
+    opciones.generar_glifos = argumentos.obtener("generar-glifos");
+    if (!argumentos.obtener_real("tolerancia", opciones.tolerancia)
+        || !argumentos.obtener_entero("repeticiones", opciones.repeticiones)
+        || !argumentos.obtener_entero("muestras-hil", muestras_hil)
+        || !argumentos.obtener_entero("glifos", glifos)) {
+        return 1;
+    }
+    opciones.muestras_hil = muestras_hil;
+    opciones.glifos = static_cast<size_t>(max(glifos, 0));
+
+    if (opciones.repeticiones < 1) {
+        cerr << "Error: --repeticiones debe ser >= 1\n";
+        return 1;
+    }
+    if (opciones.tolerancia < 0.0) {
+        cerr << "Error: --tolerancia debe ser >= 0\n";
+        return 1;
+    }
+    if (muestras_hil < 1 || glifos < 1) {
+        cerr << "Error: --muestras-hil y --glifos deben ser >= 1\n";
+        return 1;
+    }
+    ParametrosCarga parametros;
+    parametros.muestras_hil = opciones.muestras_hil;
+    parametros.glifos = opciones.glifos;
+    
+    map<string, Medicion> linea_base;
+    bool comparar = !opciones.linea_base.empty() && !opciones.actualizar_linea_base;
+    if (comparar) {
+        ParametrosCarga parametros_base;
+        linea_base = leer_linea_base(opciones.linea_base, parametros_base);
+        comparar = !linea_base.empty();
+        if (comparar && parametros_base.glifos == 0) {
+            cerr << "Error: La línea base " << opciones.linea_base << " no registra el tamaño de las "
+                 << "cargas; regenérela con --actualizar-linea-base\n";
+            return 1;
+        }
+        if (comparar && !(parametros_base == parametros)) {
+            cerr << "Error: La línea base " << opciones.linea_base << " se midió con --muestras-hil "
+                 << parametros_base.muestras_hil << " --glifos " << parametros_base.glifos
+                 << "; esta ejecución usa --muestras-hil " << parametros.muestras_hil << " --glifos "
+                 << parametros.glifos << ". Use los mismos valores o --actualizar-linea-base\n";
+            return 1;
+        }
+    }
+    
+    // Con --solo faltarían las demás cargas: la línea base guardada las
+    // perdería y las comparaciones siguientes no las medirían
+    if (!opciones.solo.empty() && !opciones.linea_base.empty() && !comparar) {
+        cerr << "Error: Con --solo no se guarda la línea base " << opciones.linea_base
+             << (opciones.actualizar_linea_base ? "" : " (no existe o está vacía)")
+             << "; ejecute todas las cargas para crearla o actualizarla\n";
+        return 1;
+    }
+    
+    vector<Carga> cargas = preparar_cargas(opciones);
+
+    ContadoresHardware contadores;
+    if (!contadores.disponibles()) {
+        cout << "Contadores de hardware no disponibles: solo se mide el tiempo\n";
+    }
+
+    cout << "\n" << left << setw(28) << "Carga" << right << setw(12) << "Tiempo ms"
+         << setw(14) << "Ciclos (M)" << setw(14) << "Instr. (M)" << setw(8) << "IPC"
+         << setw(14) << "Fallos caché" << setw(12) << "vs base" << "\n";
+    cout << "(mínimo de " << opciones.repeticiones << " repeticiones por carga)\n";
+
+    vector<pair<string, Medicion>> mediciones;
+    int regresiones = 0;
+    for (const Carga& carga : cargas) {
+        if (carga.nombre.compare(0, opciones.solo.size(), opciones.solo) != 0) continue;
+
+        // Mínimo por separado del tiempo y de cada contador
+        Medicion m;
+        for (int r = 0; r < opciones.repeticiones; ++r) {
+            Medicion actual;
+            auto inicio = chrono::steady_clock::now();
+            contadores.iniciar();
+            volatile double control = carga.ejecutar();
+            contadores.detener(actual);
+            actual.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+            (void)control;
+            
+            if (r == 0) {
+                m = actual;
+            } else {
+                m.segundos = min(m.segundos, actual.segundos);
+                m.ciclos = min(m.ciclos, actual.ciclos);
+                m.instrucciones = min(m.instrucciones, actual.instrucciones);
+                m.fallos_cache = min(m.fallos_cache, actual.fallos_cache);
+                m.hay_contadores = m.hay_contadores && actual.hay_contadores;
+            }
+        }
+        mediciones.push_back({carga.nombre, m});
+
+        cout << left << setw(28) << carga.nombre << right << fixed << setprecision(1)
+             << setw(12) << m.segundos * 1000.0;
+        if (m.hay_contadores) {
+            cout << setw(14) << m.ciclos / 1e6 << setw(14) << m.instrucciones / 1e6
+                 << setw(8) << setprecision(2) << (m.ciclos ? static_cast<double>(m.instrucciones) / m.ciclos : 0.0)
+                 << setw(14) << m.fallos_cache;
+        } else {
+            cout << setw(14) << "-" << setw(14) << "-" << setw(8) << "-" << setw(14) << "-";
+        }
+
+        // Se compara el tiempo y, si ambos lados los tienen, las
+        // instrucciones (más estables que el tiempo entre ejecuciones)
+        auto base = linea_base.find(carga.nombre);
+        if (comparar && base != linea_base.end() && base->second.segundos > 0) {
+            double cambio = m.segundos / base->second.segundos - 1.0;
+            bool regresion = cambio > opciones.tolerancia;
+            if (m.hay_contadores && base->second.hay_contadores) {
+                double cambio_instr = static_cast<double>(m.instrucciones) / base->second.instrucciones - 1.0;
+                regresion = regresion || cambio_instr > opciones.tolerancia;
+            }
+            cout << setw(11) << showpos << setprecision(1) << cambio * 100.0 << "%" << noshowpos;
+            if (regresion) {
+                cout << "  REGRESIÓN";
+                regresiones++;
+            }
+        }
+        cout << endl;
+    }
+
+    if (!opciones.linea_base.empty() && (opciones.actualizar_linea_base || linea_base.empty())) {
+        if (guardar_linea_base(opciones.linea_base, parametros, mediciones)) {
+            cout << "\nLínea base guardada en " << opciones.linea_base << "\n";
+        }
+    } else if (comparar) {
+        cout << "\nTolerancia: " << setprecision(0) << opciones.tolerancia * 100.0 << "%  Regresiones: "
+             << regresiones << "\n";
+    }
+    INSTRUMENTAR_FINALIZAR("carga_trabajo");
+    return regresiones > 0 ? 1 : 0;
+}
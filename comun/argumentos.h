@@ -0,0 +1,240 @@
+// ============================================================================
+// ARGUMENTOS DE LÍNEA DE COMANDOS Y ARCHIVOS DE CONFIGURACIÓN
+// ============================================================================
+// Analizador común para los tres programas. Cada programa declara sus
+// opciones (nombre en español, alias en inglés opcional) y obtiene los
+// valores con tipo. Un archivo de configuración (--config) usa líneas
+// "clave = valor" con los mismos nombres sin guiones; '#' inicia un
+// comentario. Los argumentos de la línea de comandos tienen prioridad
+// sobre el archivo.
+//
+//   hilos = 4
+//   formato-salida = csv
+//   silencioso = true
+// ============================================================================
+
+#ifndef ARGUMENTOS_H
+#define ARGUMENTOS_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct DefinicionOpcion {
+    string nombre;          // Sin guiones: "hilos" -> --hilos
+    string alias;           // Nombre alternativo (vacío si no hay)
+    bool requiere_valor;    // false: bandera sin valor
+    string descripcion;
+};
+
+class Argumentos {
+private:
+    vector<DefinicionOpcion> definiciones;
+    map<string, string> valores;
+    map<string, bool> desde_linea;   // Valores fijados en la línea de comandos
+
+    const DefinicionOpcion* buscar(const string& nombre) const {
+        for (const DefinicionOpcion& d : definiciones) {
+            if (d.nombre == nombre || (!d.alias.empty() && d.alias == nombre)) return &d;
+        }
+        return nullptr;
+    }
+
+    static string recortar(const string& texto) {
+        size_t inicio = texto.find_first_not_of(" \t\r");
+        if (inicio == string::npos) return "";
+        size_t fin = texto.find_last_not_of(" \t\r");
+        return texto.substr(inicio, fin - inicio + 1);
+    }
+
+public:
+    explicit Argumentos(const vector<DefinicionOpcion>& opciones) : definiciones(opciones) {
+        definiciones.push_back({"config", "", true, "Archivo de configuración (clave = valor)"});
+        definiciones.push_back({"ayuda", "help", false, "Muestra esta ayuda"});
+    }
+
+    // Analiza argv. Acepta --opcion valor y --opcion=valor. Si aparece
+    // --config, el archivo se lee después sin pisar lo dado en la línea.
+    bool analizar(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            string argumento = argv[i];
+            if (argumento.compare(0, 2, "--") != 0) {
+                cerr << "Error: Argumento inesperado: " << argumento << endl;
+                return false;
+            }
+            string nombre = argumento.substr(2);
+            string valor;
+            bool valor_en_linea = false;
+            size_t igual = nombre.find('=');
+            if (igual != string::npos) {
+                valor = nombre.substr(igual + 1);
+                nombre = nombre.substr(0, igual);
+                valor_en_linea = true;
+            }
+
+            const DefinicionOpcion* definicion = buscar(nombre);
+            if (definicion == nullptr) {
+                cerr << "Error: Opción no reconocida: --" << nombre << endl;
+                return false;
+            }
+            if (definicion->requiere_valor && !valor_en_linea) {
+                if (i + 1 >= argc) {
+                    cerr << "Error: La opción --" << nombre << " requiere un valor" << endl;
+                    return false;
+                }
+                valor = argv[++i];
+            } else if (!definicion->requiere_valor && !valor_en_linea) {
+                valor = "true";
+            }
+            valores[definicion->nombre] = valor;
+            desde_linea[definicion->nombre] = true;
+        }
+
+        if (tiene("config")) return cargar_configuracion(obtener("config"));
+        return true;
+    }
+
+    bool cargar_configuracion(const string& nombre_archivo) {
+        ifstream archivo(nombre_archivo);
+        if (!archivo.is_open()) {
+            cerr << "Error: No se pudo abrir el archivo de configuración " << nombre_archivo << endl;
+            return false;
+        }
+        string linea;
+        int numero_linea = 0;
+        while (getline(archivo, linea)) {
+            ++numero_linea;
+            size_t comentario = linea.find('#');
+            if (comentario != string::npos) linea.erase(comentario);
+            linea = recortar(linea);
+            if (linea.empty()) continue;
+
+            size_t igual = linea.find('=');
+            string clave = recortar(linea.substr(0, igual));
+            string valor = igual == string::npos ? "true" : recortar(linea.substr(igual + 1));
+            const DefinicionOpcion* definicion = buscar(clave);
+            if (definicion == nullptr || definicion->nombre == "config") {
+                cerr << "Error: " << nombre_archivo << ":" << numero_linea
+                     << ": clave no reconocida: " << clave << endl;
+                return false;
+            }
+            if (!desde_linea.count(definicion->nombre)) valores[definicion->nombre] = valor;
+        }
+        return true;
+    }
+
+    // Hay al menos una opción (línea de comandos o configuración)
+    bool hay_opciones() const { return !valores.empty(); }
+
+    bool tiene(const string& nombre) const { return valores.count(nombre) > 0; }
+
+    string obtener(const string& nombre, const string& defecto = "") const {
+        auto it = valores.find(nombre);
+        return it == valores.end() ? defecto : it->second;
+    }
+
+    // Números con tipo. Igual que obtener_lista: sin la opción deja 'valor'
+    // intacto (valor por defecto); false si el texto no es un número completo
+    // o no cabe en el tipo ("--hilos abc" no se convierte en 0)
+    bool obtener_entero(const string& nombre, int& valor) const {
+        if (!tiene(nombre)) return true;
+        string texto = obtener(nombre);
+        char* fin = nullptr;
+        errno = 0;
+        long leido = strtol(texto.c_str(), &fin, 10);
+        if (texto.empty() || fin == texto.c_str() || *fin != '\0' || errno == ERANGE
+            || leido < numeric_limits<int>::min() || leido > numeric_limits<int>::max()) {
+            cerr << "Error: Valor entero no válido en --" << nombre << ": '" << texto << "'" << endl;
+            return false;
+        }
+        valor = static_cast<int>(leido);
+        return true;
+    }
+
+    bool obtener_real(const string& nombre, double& valor) const {
+        if (!tiene(nombre)) return true;
+        string texto = obtener(nombre);
+        char* fin = nullptr;
+        errno = 0;
+        double leido = strtod(texto.c_str(), &fin);
+        if (texto.empty() || fin == texto.c_str() || *fin != '\0' || errno == ERANGE || !isfinite(leido)) {
+            cerr << "Error: Valor no numérico en --" << nombre << ": '" << texto << "'" << endl;
+            return false;
+        }
+        valor = leido;
+        return true;
+    }
+
+    // Lista de números separados por comas ("10,20,40"). Sin la opción deja
+    // 'lista' intacta (valores por defecto); false si algún elemento no es número
+    bool obtener_lista(const string& nombre, vector<double>& lista) const {
+        if (!tiene(nombre)) return true;
+        vector<double> leidos;
+        stringstream flujo(obtener(nombre));
+        string elemento;
+        while (getline(flujo, elemento, ',')) {
+            char* fin = nullptr;
+            double valor = strtod(elemento.c_str(), &fin);
+            if (elemento.empty() || fin == elemento.c_str() || *fin != '\0') {
+                cerr << "Error: Valor no numérico en --" << nombre << ": '" << elemento << "'" << endl;
+                return false;
+            }
+            leidos.push_back(valor);
+        }
+        if (leidos.empty()) {
+            cerr << "Error: --" << nombre << " requiere al menos un valor" << endl;
+            return false;
+        }
+        lista = leidos;
+        return true;
+    }
+
+    bool bandera(const string& nombre) const {
+        string valor = obtener(nombre, "false");
+        return valor == "true" || valor == "1" || valor == "si" || valor == "sí" || valor == "yes";
+    }
+
+    void mostrar_ayuda(const string& programa, const string& descripcion) const {
+        cout << "Uso: " << programa << " [opciones]\n" << descripcion << "\n\nOpciones:\n";
+        vector<string> nombres;
+        size_t ancho = 0;
+        for (const DefinicionOpcion& d : definiciones) {
+            string nombre = "--" + d.nombre + (d.requiere_valor ? " <valor>" : "");
+            if (!d.alias.empty()) nombre += ", --" + d.alias;
+            ancho = max(ancho, nombre.size());
+            nombres.push_back(nombre);
+        }
+        // La columna se ajusta al nombre más largo: siempre queda un espacio
+        // de separación antes de la descripción
+        for (size_t i = 0; i < definiciones.size(); ++i) {
+            cout << "  " << left << setw(static_cast<int>(ancho + 2)) << nombres[i] << definiciones[i].descripcion << "\n";
+        }
+    }
+};
+
+// Formatos de salida de los modos no interactivos
+enum FormatoSalida { SALIDA_TEXTO, SALIDA_CSV, SALIDA_JSON };
+
+inline bool interpretar_formato(const string& texto, FormatoSalida& formato) {
+    if (texto == "texto" || texto == "text") formato = SALIDA_TEXTO;
+    else if (texto == "csv") formato = SALIDA_CSV;
+    else if (texto == "json") formato = SALIDA_JSON;
+    else {
+        cerr << "Error: Formato de salida desconocido: " << texto << " (texto, csv o json)" << endl;
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,300 @@
+// ============================================================================
+// INSTRUMENTACIÓN DE RUTAS CRÍTICAS
+// ============================================================================
+// Temporizadores de ámbito, etapas y contadores para los tres ejercicios.
+// Se activa al compilar con TALLER_INSTRUMENTAR=1 (opción de CMake
+// TALLER_INSTRUMENTACION); en otro caso todas las macros desaparecen y sus
+// argumentos no se evalúan.
+//
+//   INSTRUMENTAR_AMBITO("puzzle.solve");          // tiempo hasta fin de ámbito
+//   INSTRUMENTAR_CONTAR("puzzle.expansiones", 1); // contador
+//   INSTRUMENTAR_CONTAR_SI("puzzle.pops_obsoletos", condicion);
+//   INSTRUMENTAR_INICIO_ETAPAS();                 // marca de referencia
+//   INSTRUMENTAR_ETAPA("hil.planta");             // tiempo desde la marca anterior
+//   INSTRUMENTAR_FINALIZAR("eje_1");              // resumen y traza_eje_1.json
+//
+// Cada hilo escribe en su propio buffer (sin candados en la ruta crítica).
+// Los temporizadores de ámbito también guardan eventos para la traza de
+// Chrome (chrome://tracing, Perfetto), hasta LIMITE_EVENTOS por hilo; las
+// etapas solo acumulan, porque se usan dentro de lazos de millones de
+// iteraciones. El reloj es el TSC en x86-64 (unos pocos ns por lectura).
+// La exportación debe hacerse cuando los demás hilos ya terminaron.
+// ============================================================================
+
+#ifndef INSTRUMENTACION_H
+#define INSTRUMENTACION_H
+
+#ifndef TALLER_INSTRUMENTAR
+#define TALLER_INSTRUMENTAR 0
+#endif
+
+#if TALLER_INSTRUMENTAR
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#if defined(_M_X64)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+namespace instrumentacion {
+
+using namespace std;
+
+const int MAX_MEDIDAS = 128;               // Puntos de medida distintos
+const size_t LIMITE_EVENTOS = 1 << 20;     // Eventos de traza por hilo
+
+enum TipoMedida { MEDIDA_AMBITO, MEDIDA_ETAPA, MEDIDA_CONTADOR };
+
+struct Evento {
+    uint64_t inicio;
+    uint64_t fin;
+    int medida;
+};
+
+struct BufferHilo {
+    int hilo = 0;
+    uint64_t ultima_marca = 0;             // Para INSTRUMENTAR_ETAPA
+    array<uint64_t, MAX_MEDIDAS> valores{};   // Ticks (tiempos) o cuenta (contadores)
+    array<uint64_t, MAX_MEDIDAS> llamadas{};
+    vector<Evento> eventos;
+};
+
+// Lectura del reloj en ticks: TSC en x86-64, steady_clock en otro caso
+inline uint64_t marca() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// Estado global: nombres de las medidas y buffers de todos los hilos
+struct Registro {
+    mutex candado;
+    vector<string> nombres;
+    vector<TipoMedida> tipos;
+    vector<unique_ptr<BufferHilo>> buffers;
+    // Referencia para convertir ticks a nanosegundos al exportar
+    uint64_t marca_inicial = marca();
+    chrono::steady_clock::time_point reloj_inicial = chrono::steady_clock::now();
+};
+
+inline Registro& registro() {
+    static Registro instancia;
+    return instancia;
+}
+
+// Devuelve el índice de la medida 'nombre', creándola si no existe. Se
+// llama una sola vez por punto de medida (variable estática en la macro).
+inline int registrar(const char* nombre, TipoMedida tipo) {
+    Registro& r = registro();
+    lock_guard<mutex> lock(r.candado);
+    for (size_t i = 0; i < r.nombres.size(); ++i) {
+        if (r.nombres[i] == nombre) return static_cast<int>(i);
+    }
+    if (r.nombres.size() >= static_cast<size_t>(MAX_MEDIDAS)) {
+        cerr << "Aviso: demasiadas medidas de instrumentación, se ignora " << nombre << endl;
+        return MAX_MEDIDAS - 1;
+    }
+    r.nombres.push_back(nombre);
+    r.tipos.push_back(tipo);
+    return static_cast<int>(r.nombres.size() - 1);
+}
+
+inline BufferHilo& buffer_hilo() {
+    thread_local BufferHilo* buffer = nullptr;
+    if (buffer == nullptr) {
+        Registro& r = registro();
+        lock_guard<mutex> lock(r.candado);
+        r.buffers.push_back(unique_ptr<BufferHilo>(new BufferHilo()));
+        buffer = r.buffers.back().get();
+        buffer->hilo = static_cast<int>(r.buffers.size());
+        buffer->ultima_marca = marca();
+    }
+    return *buffer;
+}
+
+inline void contar(int medida, uint64_t cantidad) {
+    BufferHilo& b = buffer_hilo();
+    b.valores[medida] += cantidad;
+    b.llamadas[medida]++;
+}
+
+inline void iniciar_etapas() {
+    buffer_hilo().ultima_marca = marca();
+}
+
+inline void etapa(int medida) {
+    BufferHilo& b = buffer_hilo();
+    uint64_t ahora = marca();
+    b.valores[medida] += ahora - b.ultima_marca;
+    b.llamadas[medida]++;
+    b.ultima_marca = ahora;
+}
+
+class TemporizadorAmbito {
+private:
+    int medida;
+    uint64_t inicio;
+
+public:
+    explicit TemporizadorAmbito(int id) : medida(id), inicio(marca()) {}
+
+    TemporizadorAmbito(const TemporizadorAmbito&) = delete;
+    TemporizadorAmbito& operator=(const TemporizadorAmbito&) = delete;
+
+    ~TemporizadorAmbito() {
+        uint64_t fin = marca();
+        BufferHilo& b = buffer_hilo();
+        b.valores[medida] += fin - inicio;
+        b.llamadas[medida]++;
+        if (b.eventos.size() < LIMITE_EVENTOS) b.eventos.push_back({inicio, fin, medida});
+    }
+};
+
+// Nanosegundos por tick, estimado entre el primer registro y ahora
+inline double ns_por_tick() {
+    Registro& r = registro();
+    uint64_t ticks = marca() - r.marca_inicial;
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - r.reloj_inicial).count();
+    return ticks > 0 ? ns / static_cast<double>(ticks) : 1.0;
+}
+
+// Tabla con el total de cada medida sumando todos los hilos
+inline void imprimir_resumen(ostream& salida, double escala = ns_por_tick()) {
+    Registro& r = registro();
+    lock_guard<mutex> lock(r.candado);
+
+    size_t n = r.nombres.size();
+    vector<uint64_t> valores(n, 0), llamadas(n, 0);
+    for (const auto& b : r.buffers) {
+        for (size_t i = 0; i < n; ++i) {
+            valores[i] += b->valores[i];
+            llamadas[i] += b->llamadas[i];
+        }
+    }
+
+    salida << "\n============== INSTRUMENTACIÓN ==============\n";
+    salida << left << setw(30) << "Medida" << right << setw(14) << "Llamadas"
+           << setw(14) << "Total ms" << setw(12) << "Media ns" << "\n";
+    for (size_t i = 0; i < n; ++i) {
+        salida << left << setw(30) << r.nombres[i] << right << setw(14) << llamadas[i];
+        if (r.tipos[i] == MEDIDA_CONTADOR) {
+            salida << setw(14) << valores[i] << setw(12) << "(cuenta)";
+        } else {
+            double total_ns = valores[i] * escala;
+            salida << setw(14) << fixed << setprecision(3) << total_ns / 1e6
+                   << setw(12) << setprecision(1) << (llamadas[i] ? total_ns / llamadas[i] : 0.0);
+        }
+        salida << "\n";
+    }
+    salida << "Hilos: " << r.buffers.size() << "\n";
+    salida << "=============================================\n";
+}
+
+// Traza en formato Chrome trace-event (JSON): un evento "X" por ámbito
+// medido y un evento "C" por hilo con el total de cada contador
+inline bool exportar_chrome_trace(const string& nombre_archivo, double escala = ns_por_tick()) {
+    Registro& r = registro();
+    lock_guard<mutex> lock(r.candado);
+    ofstream archivo(nombre_archivo, ios::trunc);
+    if (!archivo.is_open()) {
+        cerr << "Error: No se pudo crear la traza " << nombre_archivo << endl;
+        return false;
+    }
+
+    double escala_us = escala / 1000.0;
+    uint64_t origen = r.marca_inicial;
+    uint64_t ultimo = origen;
+    bool primero = true;
+    archivo << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    archivo << fixed << setprecision(3);
+    for (const auto& b : r.buffers) {
+        for (const Evento& e : b->eventos) {
+            archivo << (primero ? "" : ",\n") << "{\"name\":\"" << r.nombres[e.medida]
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << b->hilo
+                    << ",\"ts\":" << (e.inicio - origen) * escala_us
+                    << ",\"dur\":" << (e.fin - e.inicio) * escala_us << "}";
+            primero = false;
+            ultimo = max(ultimo, e.fin);
+        }
+    }
+    for (const auto& b : r.buffers) {
+        for (size_t i = 0; i < r.nombres.size(); ++i) {
+            if (r.tipos[i] != MEDIDA_CONTADOR || b->llamadas[i] == 0) continue;
+            archivo << (primero ? "" : ",\n") << "{\"name\":\"" << r.nombres[i]
+                    << "\",\"ph\":\"C\",\"pid\":1,\"tid\":" << b->hilo
+                    << ",\"ts\":" << (ultimo - origen) * escala_us
+                    << ",\"args\":{\"total\":" << b->valores[i] << "}}";
+            primero = false;
+        }
+    }
+    archivo << "\n]}\n";
+    return static_cast<bool>(archivo);
+}
+
+inline void finalizar(const string& programa) {
+    double escala = ns_por_tick();
+    imprimir_resumen(cerr, escala);
+    string nombre_traza = "traza_" + programa + ".json";
+    if (exportar_chrome_trace(nombre_traza, escala)) {
+        cerr << "Traza guardada en " << nombre_traza << "\n";
+    }
+}
+
+}  // namespace instrumentacion
+
+#define INSTRUMENTAR_CONCAT_(a, b) a##b
+#define INSTRUMENTAR_CONCAT(a, b) INSTRUMENTAR_CONCAT_(a, b)
+
+#define INSTRUMENTAR_AMBITO(nombre)                                                          \
+    static const int INSTRUMENTAR_CONCAT(medida_, __LINE__) =                                \
+        ::instrumentacion::registrar(nombre, ::instrumentacion::MEDIDA_AMBITO);              \
+    ::instrumentacion::TemporizadorAmbito INSTRUMENTAR_CONCAT(temporizador_, __LINE__)(      \
+        INSTRUMENTAR_CONCAT(medida_, __LINE__))
+
+#define INSTRUMENTAR_CONTAR(nombre, cantidad)                                                \
+    do {                                                                                     \
+        static const int medida_ = ::instrumentacion::registrar(nombre, ::instrumentacion::MEDIDA_CONTADOR); \
+        ::instrumentacion::contar(medida_, cantidad);                                        \
+    } while (0)
+
+#define INSTRUMENTAR_CONTAR_SI(nombre, condicion)                                            \
+    do {                                                                                     \
+        if (condicion) INSTRUMENTAR_CONTAR(nombre, 1);                                       \
+    } while (0)
+
+#define INSTRUMENTAR_INICIO_ETAPAS() ::instrumentacion::iniciar_etapas()
+
+#define INSTRUMENTAR_ETAPA(nombre)                                                           \
+    do {                                                                                     \
+        static const int medida_ = ::instrumentacion::registrar(nombre, ::instrumentacion::MEDIDA_ETAPA); \
+        ::instrumentacion::etapa(medida_);                                                   \
+    } while (0)
+
+#define INSTRUMENTAR_FINALIZAR(programa) ::instrumentacion::finalizar(programa)
+
+#else
+
+#define INSTRUMENTAR_AMBITO(nombre) ((void)0)
+#define INSTRUMENTAR_CONTAR(nombre, cantidad) ((void)0)
+#define INSTRUMENTAR_CONTAR_SI(nombre, condicion) ((void)0)
+#define INSTRUMENTAR_INICIO_ETAPAS() ((void)0)
+#define INSTRUMENTAR_ETAPA(nombre) ((void)0)
+#define INSTRUMENTAR_FINALIZAR(programa) ((void)0)
+
+#endif
+
+#endif
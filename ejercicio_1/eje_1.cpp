@@ -1,179 +1,228 @@
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <vector>
-#include <queue>
-#include <unordered_map>
 #include <string>
+#include <chrono>
+#include <thread>
+#include <atomic>
 #include <algorithm>
+#ifdef _WIN32
 #include <windows.h>   // Para activar UTF-8 en Windows
+#endif
+
+#include "puzzle.h"
+#include "instrumentacion.h"
+#include "argumentos.h"
 
 using namespace std;
 
-using State = string;
-const std::string GOAL = "123456780";
-
-int dx[4] = {-1, 1, 0, 0};
-int dy[4] = {0, 0, -1, 1};
-
-int posToIndex(int x, int y) { return x * 3 + y; }
-
-// ======================= IMPRESIÓN =======================
-void printState(const State& s) {
-    cout << "+---+---+---+\n";
-    for (int i = 0; i < 9; ++i) {
-        cout << "| ";
-        if (s[i] == '0')
-            cout << " ";
-        else
-            cout << s[i];
-        cout << " ";
-        if (i % 3 == 2) {
-            cout << "|\n";
-            cout << "+---+---+---+\n";
+// ======================= MODO POR LOTES =======================
+// eje_1 --tablero 123456780 | --entrada archivo [--hilos N] [--silencioso]
+//       [--formato-salida texto|csv|json] [--salida archivo] [--tableros]
+// El archivo tiene un tablero por línea: los 9 dígitos juntos o separados
+// por espacios, opcionalmente precedidos de la profundidad (así sirve
+// también el corpus "profundidad tablero"); '#' comenta.
+
+// Interpreta un tablero: exactamente 9 dígitos del 0 al 8 sin repetir.
+// Con admitir_profundidad, acepta además "profundidad tablero"
+bool interpretarTablero(const string& texto, State& tablero, bool admitir_profundidad) {
+    vector<string> partes;
+    string parte;
+    for (char c : texto) {
+        if (c == '#') break;
+        if (c == ' ' || c == '\t' || c == '\r') {
+            if (!parte.empty()) partes.push_back(parte);
+            parte.clear();
+        } else if (c >= '0' && c <= '9') {
+            parte += c;
+        } else {
+            return false;
         }
     }
-    cout << "\n";
-}
-// ==========================================================
-
-// ================ HEURÍSTICA MANHATTAN ====================
-int heuristic(const State& s) {
-    int dist = 0;
+    if (!parte.empty()) partes.push_back(parte);
 
-    for (int i = 0; i < 9; ++i) {
+    if (admitir_profundidad && partes.size() == 2 && partes[1].size() == 9) {
+        tablero = partes[1];
+    } else {
+        tablero.clear();
+        for (const string& p : partes) tablero += p;
+    }
+    if (tablero.size() != 9) return false;
 
-        int val = s[i] - '0';
-        int cur_x = i / 3;
-        int cur_y = i % 3;
+    vector<bool> usado(9, false);
+    for (char c : tablero) {
+        int v = c - '0';
+        if (v > 8 || usado[v]) return false;
+        usado[v] = true;
+    }
+    return true;
+}
 
-        int target_x, target_y;
+struct ResultadoTablero {
+    State tablero;
+    bool soluble = false;
+    ResultadoPuzzle resultado;
+    double milisegundos = 0.0;
+};
+
+void escribirResultados(ostream& salida, const vector<ResultadoTablero>& resultados, FormatoSalida formato) {
+    if (formato == SALIDA_CSV) {
+        salida << "tablero,soluble,movimientos,nodos,ms,solucion\n";
+    } else if (formato == SALIDA_JSON) {
+        salida << "[\n";
+    }
 
-        if (val == 0) {
-            target_x = 1; target_y = 1; // posición del 0 en GOAL
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoTablero& r = resultados[i];
+        int movimientos = r.resultado.resuelto ? r.resultado.movimientos : -1;
+        salida << fixed << setprecision(3);
+        if (formato == SALIDA_TEXTO) {
+            salida << r.tablero << " ";
+            if (r.soluble) salida << movimientos << " movimientos, " << r.resultado.nodos << " nodos";
+            else salida << "sin solución";
+            salida << ", " << r.milisegundos << " ms";
+            if (!r.resultado.solucion.empty()) salida << ", " << r.resultado.solucion;
+            salida << "\n";
+        } else if (formato == SALIDA_CSV) {
+            salida << r.tablero << "," << (r.soluble ? 1 : 0) << "," << movimientos << ","
+                   << r.resultado.nodos << "," << r.milisegundos << "," << r.resultado.solucion << "\n";
         } else {
-            target_x = (val - 1) / 3;
-            target_y = (val - 1) % 3;
+            salida << "  {\"tablero\": \"" << r.tablero << "\", \"soluble\": " << (r.soluble ? "true" : "false")
+                   << ", \"movimientos\": " << movimientos << ", \"nodos\": " << r.resultado.nodos
+                   << ", \"ms\": " << r.milisegundos << ", \"solucion\": \"" << r.resultado.solucion << "\"}"
+                   << (i + 1 < resultados.size() ? "," : "") << "\n";
         }
-
-        dist += abs(cur_x - target_x) + abs(cur_y - target_y);
     }
-    return dist;
-}
-// ==========================================================
-
-// ================ GENERACIÓN DE VECINOS ===================
-vector<State> getNeighbors(const State& s) {
-    vector<State> neighbors;
-
-    int pos = static_cast<int>(s.find('0'));
-    int x = pos / 3, y = pos % 3;
 
-    for (int d = 0; d < 4; ++d) {
-        int nx = x + dx[d], ny = y + dy[d];
+    if (formato == SALIDA_JSON) salida << "]\n";
+}
 
-        if (nx >= 0 && nx < 3 && ny >= 0 && ny < 3) {
-            State nxt = s;
-            swap(nxt[pos], nxt[posToIndex(nx, ny)]);
-            neighbors.push_back(nxt);
+int ejecutarLotes(const Argumentos& argumentos) {
+    FormatoSalida formato = SALIDA_TEXTO;
+    if (!interpretar_formato(argumentos.obtener("formato-salida", "texto"), formato)) return 1;
+    bool silencioso = argumentos.bandera("silencioso");
+    // Todas las opciones se validan antes de cualquier salida anticipada
+    int hilos = 1;
+    if (!argumentos.obtener_entero("hilos", hilos)) return 1;
+
+    // Tableros de la línea de comandos o del archivo
+    vector<ResultadoTablero> resultados;
+    if (argumentos.tiene("tablero")) {
+        ResultadoTablero r;
+        if (!interpretarTablero(argumentos.obtener("tablero"), r.tablero, false)) {
+            cerr << "Error: Tablero inválido: '" << argumentos.obtener("tablero")
+                 << "' (se esperan 9 dígitos del 0 al 8 sin repetir)" << endl;
+            return 1;
         }
+        resultados.push_back(r);
     }
-    return neighbors;
-}
-// ==========================================================
-
-// ================ RECONSTRUCCIÓN DE CAMINO ================
-vector<State> reconstructPath(unordered_map<State, State>& parent, State curr) {
-    vector<State> path;
-
-    while (curr != parent[curr]) {
-        path.push_back(curr);
-        curr = parent[curr];
+    if (argumentos.tiene("entrada")) {
+        ifstream archivo(argumentos.obtener("entrada"));
+        if (!archivo.is_open()) {
+            cerr << "Error: No se pudo abrir el archivo " << argumentos.obtener("entrada") << endl;
+            return 1;
+        }
+        string linea;
+        int numero_linea = 0;
+        while (getline(archivo, linea)) {
+            ++numero_linea;
+            if (linea.find_first_not_of(" \t\r") == string::npos || linea[linea.find_first_not_of(" \t\r")] == '#') continue;
+            ResultadoTablero r;
+            if (!interpretarTablero(linea, r.tablero, true)) {
+                cerr << "Error: Tablero inválido en la línea " << numero_linea << ": '" << linea
+                     << "' (se esperan 9 dígitos del 0 al 8 sin repetir)" << endl;
+                return 1;
+            }
+            resultados.push_back(r);
+        }
+    }
+    if (resultados.empty()) {
+        cerr << "Error: Indique --tablero o --entrada (use --ayuda para ver las opciones)\n";
+        return 1;
     }
-    path.push_back(curr);
-    reverse(path.begin(), path.end());
-
-    return path;
-}
-// ==========================================================
-
-// ================ VERIFICADOR DE SOLUBILIDAD ==============
-bool esSoluble(const string& s) {
-    vector<int> v;
-
-    for (char c : s)
-        if (c != '0')
-            v.push_back(c - '0');
-
-    int inv = 0;
-    int n = static_cast<int>(v.size());
-
-    for (int i = 0; i < n; i++)
-        for (int j = i + 1; j < n; j++)
-            if (v[i] > v[j])
-                inv++;
-
-    return (inv % 2 == 0);
-}
-// ==========================================================
-
-// ================ ALGORITMO A* ============================
-bool solvePuzzle(const State& start) {
-
-    auto cmp = [](const pair<int, State>& a, const pair<int, State>& b) {
-        return a.first > b.first;
-    };
-
-    priority_queue<pair<int, State>, vector<pair<int, State>>, decltype(cmp)> pq(cmp);
-
-    unordered_map<State, int> g;
-    unordered_map<State, State> parent;
-
-    g[start]     = 0;
-    parent[start] = start;
-    pq.push({heuristic(start), start});
-
-    int nodos = 0;
-
-    while (!pq.empty()) {
-        State curr = pq.top().second; 
-        pq.pop();
-        nodos++;
-
-        if (curr == GOAL) {
-            cout << "\n✓ Solución encontrada en " << g[curr] 
-                 << " movimientos (" << nodos << " nodos explorados)\n\n";
-
-            vector<State> path = reconstructPath(parent, curr);
 
-            for (size_t i = 0; i < path.size(); ++i) {
-                cout << "Paso " << i << ":\n";
-                printState(path[i]);
-                if (i < path.size() - 1)
-                    cout << "   ↓\n";
-            }
-            return true;
+    // Un solo tablero en texto y sin --silencioso: igual que el modo interactivo
+    if (resultados.size() == 1 && formato == SALIDA_TEXTO && !silencioso && !argumentos.tiene("salida")) {
+        cout << "Tablero inicial:\n";
+        printState(resultados[0].tablero);
+        if (!esSoluble(resultados[0].tablero)) {
+            cout << "✗ Este rompecabezas NO tiene solución posible.\n";
+            return 0;
         }
+        return solvePuzzle(resultados[0].tablero, true, argumentos.bandera("tableros")) ? 0 : 1;
+    }
 
-        for (const State& next : getNeighbors(curr)) {
-            int tg = g[curr] + 1;
+    // Los hilos toman el siguiente tablero pendiente; cada resultado se
+    // guarda en su posición, así la salida no depende del número de hilos
+    if (hilos <= 0) hilos = max(1u, thread::hardware_concurrency());
+    hilos = min<int>(hilos, static_cast<int>(resultados.size()));
+
+    atomic<size_t> siguiente(0);
+    auto trabajar = [&]() {
+        for (size_t i = siguiente++; i < resultados.size(); i = siguiente++) {
+            ResultadoTablero& r = resultados[i];
+            auto inicio = chrono::steady_clock::now();
+            r.soluble = esSoluble(r.tablero);
+            if (r.soluble) r.resultado = resolverPuzzle(r.tablero);
+            r.milisegundos = chrono::duration<double, milli>(chrono::steady_clock::now() - inicio).count();
+        }
+    };
 
-            if (!g.count(next) || tg < g[next]) {
-                g[next] = tg;
-                parent[next] = curr;
-                pq.push({tg + heuristic(next), next});
-            }
+    auto inicio = chrono::steady_clock::now();
+    vector<thread> trabajadores;
+    for (int h = 1; h < hilos; ++h) trabajadores.emplace_back(trabajar);
+    trabajar();
+    for (thread& t : trabajadores) t.join();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    // La escritura queda fuera de la medición
+    if (argumentos.tiene("salida")) {
+        ofstream salida(argumentos.obtener("salida"));
+        if (!salida.is_open()) {
+            cerr << "Error: No se pudo crear el archivo " << argumentos.obtener("salida") << endl;
+            return 1;
         }
+        escribirResultados(salida, resultados, formato);
+    } else {
+        escribirResultados(cout, resultados, formato);
     }
 
-    cout << "\nNo hay solución.\n";
-    return false;
+    if (!silencioso) {
+        cerr << resultados.size() << " tableros resueltos en " << fixed << setprecision(3) << segundos
+             << " s con " << hilos << " hilo(s) (" << setprecision(1)
+             << (segundos > 0 ? resultados.size() / segundos : 0.0) << " tableros/s)\n";
+    }
+    return 0;
 }
-// ==========================================================
 
-int main() {
+int main(int argc, char* argv[]) {
 
     // ACTIVAR UTF-8 EN WINDOWS PARA TILDES
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
+#endif
+
+    Argumentos argumentos({
+        {"tablero", "board", true, "Tablero a resolver, p. ej. 572410386"},
+        {"entrada", "input", true, "Archivo con un tablero por línea"},
+        {"hilos", "threads", true, "Hilos para resolver varios tableros (0 = todos los núcleos)"},
+        {"silencioso", "quiet", false, "Sin dibujar tableros ni resumen de tiempos"},
+        {"formato-salida", "output-format", true, "texto, csv o json"},
+        {"salida", "output", true, "Archivo de resultados (por defecto, la consola)"},
+        {"tableros", "boards", false, "Dibuja el tablero de cada paso (un solo tablero, formato texto)"},
+    });
+    if (!argumentos.analizar(argc, argv)) return 1;
+    if (argumentos.bandera("ayuda")) {
+        argumentos.mostrar_ayuda("eje_1", "Resolvedor de 8-puzzle con A*. Sin opciones se ejecuta el modo interactivo.");
+        return 0;
+    }
+    if (argumentos.hay_opciones()) {
+        int codigo = ejecutarLotes(argumentos);
+        INSTRUMENTAR_FINALIZAR("eje_1");
+        return codigo;
+    }
 
     cout << "=====================================\n";
     cout << "        RESOLVEDOR DE 8-PUZZLE\n";
@@ -210,9 +259,16 @@ int main() {
     }
     // ========================================================================
 
-    cout << "✓ El rompecabezas es soluble. Buscando solución...\n";
+    // La visualización paso a paso es opcional: por defecto la solución
+    // se muestra solo como cadena de movimientos
+    cout << "¿Mostrar los tableros de cada paso? (s/n): ";
+    string respuesta;
+    bool mostrarTableros = (cin >> respuesta) && (respuesta == "s" || respuesta == "S");
+
+    cout << "\n✓ El rompecabezas es soluble. Buscando solución...\n";
 
-    solvePuzzle(inicio);
+    solvePuzzle(inicio, true, mostrarTableros);
 
+    INSTRUMENTAR_FINALIZAR("eje_1");
     return 0;
-}
\ No newline at end of file
+}
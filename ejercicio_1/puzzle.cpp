@@ -0,0 +1,235 @@
+#include "puzzle.h"
+#include "instrumentacion.h"
+
+#include <iostream>
+#include <queue>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+static int dx[4] = {-1, 1, 0, 0};
+static int dy[4] = {0, 0, -1, 1};
+
+int posToIndex(int x, int y) { return x * 3 + y; }
+
+// ======================= IMPRESIÓN =======================
+void printState(const State& s) {
+    cout << "+---+---+---+\n";
+    for (int i = 0; i < 9; ++i) {
+        cout << "| ";
+        if (s[i] == '0')
+            cout << " ";
+        else
+            cout << s[i];
+        cout << " ";
+        if (i % 3 == 2) {
+            cout << "|\n";
+            cout << "+---+---+---+\n";
+        }
+    }
+    cout << "\n";
+}
+// ==========================================================
+
+// ================ HEURÍSTICA MANHATTAN ====================
+int heuristic(const State& s) {
+    int dist = 0;
+
+    for (int i = 0; i < 9; ++i) {
+
+        int val = s[i] - '0';
+        int cur_x = i / 3;
+        int cur_y = i % 3;
+
+        int target_x, target_y;
+
+        if (val == 0) {
+            target_x = 1; target_y = 1; // posición del 0 en GOAL
+        } else {
+            target_x = (val - 1) / 3;
+            target_y = (val - 1) % 3;
+        }
+
+        dist += abs(cur_x - target_x) + abs(cur_y - target_y);
+    }
+    return dist;
+}
+// ==========================================================
+
+// ================ GENERACIÓN DE VECINOS ===================
+vector<State> getNeighbors(const State& s) {
+    vector<State> neighbors;
+
+    int pos = static_cast<int>(s.find('0'));
+    int x = pos / 3, y = pos % 3;
+
+    for (int d = 0; d < 4; ++d) {
+        int nx = x + dx[d], ny = y + dy[d];
+
+        if (nx >= 0 && nx < 3 && ny >= 0 && ny < 3) {
+            State nxt = s;
+            swap(nxt[pos], nxt[posToIndex(nx, ny)]);
+            neighbors.push_back(nxt);
+        }
+    }
+    return neighbors;
+}
+// ==========================================================
+
+// ================ RECONSTRUCCIÓN DE CAMINO ================
+string reconstruirMovimientos(const unordered_map<State, int>& visitados, State curr) {
+    string movimientos;
+    int pos = static_cast<int>(curr.find('0'));
+
+    // Solo el estado inicial tiene g = 0
+    for (auto it = visitados.find(curr); it != visitados.end() && (it->second >> 2) > 0;
+         it = visitados.find(curr)) {
+        int d = it->second & 3;
+        movimientos.push_back(LETRAS_MOVIMIENTO[d]);
+
+        // Deshacer: el hueco vuelve a la casilla opuesta a la dirección
+        int anterior = posToIndex(pos / 3 - dx[d], pos % 3 - dy[d]);
+        swap(curr[pos], curr[anterior]);
+        pos = anterior;
+    }
+    reverse(movimientos.begin(), movimientos.end());
+
+    return movimientos;
+}
+
+vector<State> aplicarMovimientos(const State& start, const string& movimientos) {
+    vector<State> path(1, start);
+    State curr = start;
+    int pos = static_cast<int>(curr.find('0'));
+
+    for (char m : movimientos) {
+        int d = static_cast<int>(find(LETRAS_MOVIMIENTO, LETRAS_MOVIMIENTO + 4, m) - LETRAS_MOVIMIENTO);
+        int nx = pos / 3 + dx[d], ny = pos % 3 + dy[d];
+        if (d == 4 || nx < 0 || nx >= 3 || ny < 0 || ny >= 3) break;   // Movimiento inválido
+        swap(curr[pos], curr[posToIndex(nx, ny)]);
+        pos = posToIndex(nx, ny);
+        path.push_back(curr);
+    }
+
+    return path;
+}
+// ==========================================================
+
+// ================ VERIFICADOR DE SOLUBILIDAD ==============
+bool esSoluble(const string& s) {
+    vector<int> v;
+
+    for (char c : s)
+        if (c != '0')
+            v.push_back(c - '0');
+
+    int inv = 0;
+    int n = static_cast<int>(v.size());
+
+    for (int i = 0; i < n; i++)
+        for (int j = i + 1; j < n; j++)
+            if (v[i] > v[j])
+                inv++;
+
+    return (inv % 2 == 0);
+}
+// ==========================================================
+
+// ================ ALGORITMO A* ============================
+ResultadoPuzzle resolverPuzzle(const State& start, bool guardarSolucion) {
+
+    auto cmp = [](const pair<int, State>& a, const pair<int, State>& b) {
+        return a.first > b.first;
+    };
+
+    priority_queue<pair<int, State>, vector<pair<int, State>>, decltype(cmp)> pq(cmp);
+
+    INSTRUMENTAR_AMBITO("puzzle.resolver");
+
+    ResultadoPuzzle resultado;
+
+    // g * 4 + movimiento que llevó al estado: un solo mapa con valores
+    // enteros en lugar de g y un mapa de padres con tableros completos
+    unordered_map<State, int> visitados;
+
+    visitados[start] = 0;
+    pq.push({heuristic(start), start});
+    INSTRUMENTAR_CONTAR("puzzle.pushes", 1);
+    INSTRUMENTAR_CONTAR("puzzle.busquedas_mapa", 1);
+
+    int nodos = 0;
+
+    while (!pq.empty()) {
+        State curr = pq.top().second; 
+        int g = visitados.find(curr)->second >> 2;
+        INSTRUMENTAR_CONTAR("puzzle.busquedas_mapa", 1);
+        // Un pop es obsoleto si el estado ya se alcanzó con menor costo
+        // después de insertarlo (su f guardada supera g + h actual)
+        INSTRUMENTAR_CONTAR_SI("puzzle.pops_obsoletos", pq.top().first > g + heuristic(curr));
+        pq.pop();
+        nodos++;
+
+        if (curr == GOAL) {
+            resultado.resuelto = true;
+            resultado.movimientos = g;
+            resultado.nodos = nodos;
+            if (guardarSolucion) resultado.solucion = reconstruirMovimientos(visitados, curr);
+            return resultado;
+        }
+
+        INSTRUMENTAR_CONTAR("puzzle.expansiones", 1);
+        int pos = static_cast<int>(curr.find('0'));
+        int x = pos / 3, y = pos % 3;
+        int tg = g + 1;
+
+        for (int d = 0; d < 4; ++d) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (nx < 0 || nx >= 3 || ny < 0 || ny >= 3) continue;
+
+            State next = curr;
+            swap(next[pos], next[posToIndex(nx, ny)]);
+
+            // Una sola búsqueda: inserta si es nuevo o encuentra el existente
+            auto insercion = visitados.try_emplace(next, tg * 4 + d);
+            INSTRUMENTAR_CONTAR("puzzle.busquedas_mapa", 1);
+            if (insercion.second || tg < (insercion.first->second >> 2)) {
+                insercion.first->second = tg * 4 + d;
+                pq.push({tg + heuristic(next), move(next)});
+                INSTRUMENTAR_CONTAR("puzzle.pushes", 1);
+            }
+        }
+    }
+
+    resultado.nodos = nodos;
+    return resultado;
+}
+
+bool solvePuzzle(const State& start, bool mostrarSolucion, bool mostrarTableros) {
+    ResultadoPuzzle resultado = resolverPuzzle(start, mostrarSolucion);
+    if (!mostrarSolucion) return resultado.resuelto;
+
+    if (!resultado.resuelto) {
+        cout << "\nNo hay solución.\n";
+        return false;
+    }
+
+    cout << "\n✓ Solución encontrada en " << resultado.movimientos 
+         << " movimientos (" << resultado.nodos << " nodos explorados)\n";
+    cout << "Movimientos del espacio vacío: "
+         << (resultado.solucion.empty() ? "(ninguno)" : resultado.solucion) << "\n\n";
+
+    if (!mostrarTableros) return true;
+
+    vector<State> path = aplicarMovimientos(start, resultado.solucion);
+    for (size_t i = 0; i < path.size(); ++i) {
+        cout << "Paso " << i;
+        if (i > 0) cout << " (" << resultado.solucion[i - 1] << ")";
+        cout << ":\n";
+        printState(path[i]);
+        if (i < path.size() - 1)
+            cout << "   ↓\n";
+    }
+    return true;
+}
+// ==========================================================
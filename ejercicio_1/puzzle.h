@@ -0,0 +1,62 @@
+// ============================================================================
+// RESOLVEDOR DE 8-PUZZLE - BIBLIOTECA
+// ============================================================================
+// Representación del tablero, heurística Manhattan, generación de vecinos
+// y búsqueda A*. El programa interactivo está en eje_1.cpp.
+// ============================================================================
+
+#ifndef PUZZLE_H
+#define PUZZLE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+using State = string;
+const std::string GOAL = "123456780";
+
+int posToIndex(int x, int y);
+
+// ======================= IMPRESIÓN =======================
+void printState(const State& s);
+
+// ================ HEURÍSTICA MANHATTAN ====================
+int heuristic(const State& s);
+
+// ================ GENERACIÓN DE VECINOS ===================
+vector<State> getNeighbors(const State& s);
+
+// ================ RECONSTRUCCIÓN DE CAMINO ================
+// Cada estado alcanzado guarda g * 4 + dirección (2 bits) del movimiento
+// del hueco que lo generó; la solución se reconstruye deshaciendo esos
+// movimientos desde la meta, sin guardar el tablero padre.
+const char LETRAS_MOVIMIENTO[4] = {'U', 'D', 'L', 'R'};   // Hueco arriba, abajo, izquierda, derecha
+
+string reconstruirMovimientos(const unordered_map<State, int>& visitados, State curr);
+
+// Tableros por los que pasa la solución (para la visualización paso a paso)
+vector<State> aplicarMovimientos(const State& start, const string& movimientos);
+
+// ================ VERIFICADOR DE SOLUBILIDAD ==============
+bool esSoluble(const string& s);
+
+// ================ ALGORITMO A* ============================
+struct ResultadoPuzzle {
+    bool resuelto = false;
+    int movimientos = -1;
+    int nodos = 0;              // Nodos extraídos de la cola de prioridad
+    string solucion;            // Movimientos del hueco, p. ej. "ULDR" (si se pidió)
+};
+
+// Búsqueda sin salida por consola; reentrante, se puede llamar desde
+// varios hilos a la vez
+ResultadoPuzzle resolverPuzzle(const State& start, bool guardarSolucion = true);
+
+// Con mostrarSolucion = false no imprime nada (útil para medir tiempos).
+// Imprime la cadena de movimientos; los tableros de cada paso solo con
+// mostrarTableros.
+bool solvePuzzle(const State& start, bool mostrarSolucion = true, bool mostrarTableros = false);
+
+#endif
@@ -1,296 +1,234 @@
 #include <iostream>
 #include <fstream>
-#include <vector>
-#include <cmath>
 #include <iomanip>
 #include <string>
-#include <chrono>
+#include <vector>
 #include <thread>
+#include <memory>
+#ifdef _WIN32
 #include <windows.h>
+#endif
+
+#include "hil.h"
+#include "monte_carlo.h"
+#include "instrumentacion.h"
+#include "argumentos.h"
 using namespace std;
 
-// ==================== CONSTANTES ====================
-const double TAU_S = 0.004;      // Tiempo de muestreo (250 Hz)
-const double L = 1.8;            // Constante de Lipschitz
-const double LAMBDA_0 = 1.3;
-const double LAMBDA_1 = 1.85;
-const double LAMBDA_2 = 2.79;
-const double LAMBDA_3 = 6.48;
+// ==================== MODO POR LOTES ====================
+// eje_2 --senal escalon|rampa|senoidal|todas [--amplitud A] [--frecuencia F]
+//       [--duracion S] [--salida archivo] [--hilos N] [--silencioso]
+//       [--formato-salida texto|csv|json] [--comparar-escalares]
+//       [--monte-carlo [--ruido R] [--nivel X] [--ensayos N] [--semilla S]]
+// Con "todas" se simulan las tres señales del menú (opción 4), cada una en
+// su archivo; con --hilos > 1 se ejecutan en paralelo (cada simulación
+// tiene su planta, derivador y archivo, no comparten estado).
 
-// ==================== FUNCIONES AUXILIARES ====================
-double signo(double x) {
-    if (x > 0) return 1.0;
-    if (x < 0) return -1.0;
-    return 0.0;
+struct TrabajoSimulacion {
+    string nombre;
+    GeneradorSenal::TipoSenal tipo;
+    double amplitud;
+    double frecuencia;
+    string archivo;
+};
+
+bool interpretarSenal(const string& texto, GeneradorSenal::TipoSenal& tipo) {
+    if (texto == "escalon" || texto == "escalón" || texto == "step") tipo = GeneradorSenal::ESCALON;
+    else if (texto == "rampa" || texto == "ramp") tipo = GeneradorSenal::RAMPA;
+    else if (texto == "senoidal" || texto == "sine") tipo = GeneradorSenal::SENOIDAL;
+    else return false;
+    return true;
 }
 
-// ==================== CLASE: PLANTA SISO ====================
-class PlantaG {
-private:
-    // Coeficientes de la función de transferencia
-    // G(s) = (7s^2 - 28s + 21) / (s^3 + 9.8s^2 + 30.65s + 30.1)
-    
-    // Estados discretizados usando método Tustin (bilinear)
-    vector<double> estados_x;  // Estados de la planta
-    vector<double> historial_u;  // Historial de entradas
-    vector<double> historial_y;  // Historial de salidas
-    
-    // Coeficientes discretizados (Tustin con Ts = 0.004)
-    double a0, a1, a2, a3;  // Denominador
-    double b0, b1, b2, b3;  // Numerador
+// ==================== RESULTADOS MONTE CARLO ====================
+struct CorridaMonteCarlo {
+    string senal;
+    ConfigMonteCarlo config;
+    ResultadoMonteCarlo resultado;
+};
 
-public:
-    PlantaG() {
-        // Inicialización de estados
-        estados_x.resize(3, 0.0);
-        historial_u.resize(3, 0.0);
-        historial_y.resize(3, 0.0);
-        
-        // Discretización usando Tustin (aproximación)
-        // Estos coeficientes se calculan a partir de c2d en MATLAB/Python
-        // Para simplificar, usamos una aproximación de la respuesta al escalón
-        
-        // Coeficientes aproximados para Ts = 0.004
-        a0 = 1.0;
-        a1 = -2.88232;
-        a2 = 2.76606;
-        a3 = -0.88371;
-        
-        b0 = 0.00002334;
-        b1 = -0.00004668;
-        b2 = 0.00002334;
-        b3 = 0.0;
+void mostrarMonteCarlo(const vector<CorridaMonteCarlo>& corridas, FormatoSalida formato) {
+    const char* estimaciones[ORDENES_MONTE_CARLO] = {"z0", "z1"};
+
+    if (formato == SALIDA_CSV) {
+        cout << "senal,ruido,nivel,ensayos,estimacion,sesgo,desviacion,maximo_abs,rms_medio,rms_desviacion,rms_peor,rms_sin_ruido,segundos\n";
+    } else if (formato == SALIDA_JSON) {
+        cout << "[\n";
     }
-    
-    double actualizar(double entrada_u) {
-        // Ecuación en diferencias de 3er orden
-        // y[k] = -a1*y[k-1] - a2*y[k-2] - a3*y[k-3] + b0*u[k] + b1*u[k-1] + b2*u[k-2]
-        
-        double salida_y = -a1 * historial_y[0] - a2 * historial_y[1] - a3 * historial_y[2]
-                          + b0 * entrada_u + b1 * historial_u[0] + b2 * historial_u[1];
-        
-        // Actualizar historiales
-        historial_y[2] = historial_y[1];
-        historial_y[1] = historial_y[0];
-        historial_y[0] = salida_y;
-        
-        historial_u[2] = historial_u[1];
-        historial_u[1] = historial_u[0];
-        historial_u[0] = entrada_u;
-        
-        return salida_y;
+
+    for (size_t c = 0; c < corridas.size(); ++c) {
+        const ConfigMonteCarlo& cfg = corridas[c].config;
+        const ResultadoMonteCarlo& r = corridas[c].resultado;
+
+        if (formato == SALIDA_TEXTO) {
+            cout << "\n========================================\n";
+            cout << "   MONTE CARLO - " << corridas[c].senal << "\n";
+            cout << "========================================\n\n";
+            cout << "Ruido: " << nombreRuido(cfg.ruido) << " (nivel " << cfg.nivel;
+            if (cfg.ruido == RUIDO_ATIPICOS) cout << ", probabilidad " << cfg.prob_atipico << ", magnitud " << cfg.magnitud_atipico;
+            cout << ")\n";
+            cout << "Ensayos: " << r.ensayos << " de " << cfg.duracion << " s (se descartan los primeros "
+                 << cfg.transitorio << " s), semilla " << cfg.semilla << "\n";
+            cout << "Tiempo: " << fixed << setprecision(3) << r.segundos << " s con " << r.hilos << " hilo(s)\n\n";
+            cout << left << setw(10) << "Error" << right << setw(13) << "Sesgo" << setw(13) << "Desviación"
+                 << setw(13) << "Máx |e|" << setw(13) << "RMS medio" << setw(13) << "RMS desv." << setw(13) << "RMS peor" << setw(13) << "Sin ruido" << "\n";
+        }
+
+        for (int o = 0; o < ORDENES_MONTE_CARLO; ++o) {
+            const EstadisticaWelford& e = r.error[o];
+            const EstadisticaWelford& rms = r.rms_ensayo[o];
+            if (formato == SALIDA_TEXTO) {
+                cout << left << setw(10) << estimaciones[o] << right << scientific << setprecision(4)
+                     << setw(13) << e.media << setw(13) << e.desviacion() << setw(13) << e.maximo_abs
+                     << setw(13) << rms.media << setw(13) << rms.desviacion() << setw(13) << rms.maximo_abs
+                     << setw(13) << r.sin_ruido[o].rms() << "\n";
+            } else if (formato == SALIDA_CSV) {
+                cout << corridas[c].senal << "," << nombreRuido(cfg.ruido) << "," << cfg.nivel << "," << r.ensayos
+                     << "," << estimaciones[o] << scientific << setprecision(6) << "," << e.media << "," << e.desviacion()
+                     << "," << e.maximo_abs << "," << rms.media << "," << rms.desviacion() << "," << rms.maximo_abs
+                     << "," << r.sin_ruido[o].rms() << "," << fixed << setprecision(4) << r.segundos << defaultfloat << "\n";
+            } else {
+                cout << "  {\"senal\": \"" << corridas[c].senal << "\", \"ruido\": \"" << nombreRuido(cfg.ruido)
+                     << "\", \"nivel\": " << cfg.nivel << ", \"ensayos\": " << r.ensayos
+                     << ", \"estimacion\": \"" << estimaciones[o] << "\"" << scientific << setprecision(6)
+                     << ", \"sesgo\": " << e.media << ", \"desviacion\": " << e.desviacion()
+                     << ", \"maximo_abs\": " << e.maximo_abs << ", \"rms_medio\": " << rms.media
+                     << ", \"rms_desviacion\": " << rms.desviacion() << ", \"rms_peor\": " << rms.maximo_abs
+                     << ", \"rms_sin_ruido\": " << r.sin_ruido[o].rms()
+                     << ", \"segundos\": " << fixed << setprecision(4) << r.segundos << defaultfloat << "}"
+                     << (c + 1 < corridas.size() || o + 1 < ORDENES_MONTE_CARLO ? "," : "") << "\n";
+            }
+        }
+        cout << defaultfloat;
     }
-    
-    void reiniciar() {
-        fill(estados_x.begin(), estados_x.end(), 0.0);
-        fill(historial_u.begin(), historial_u.end(), 0.0);
-        fill(historial_y.begin(), historial_y.end(), 0.0);
+
+    if (formato == SALIDA_JSON) cout << "]\n";
+}
+
+int ejecutarLotes(const Argumentos& argumentos) {
+    FormatoSalida formato = SALIDA_TEXTO;
+    if (!interpretar_formato(argumentos.obtener("formato-salida", "texto"), formato)) return 1;
+    bool silencioso = argumentos.bandera("silencioso");
+    double duracion = 10.0;
+    if (!argumentos.obtener_real("duracion", duracion)) return 1;
+    if (duracion <= 0) {
+        cerr << "Error: La duración debe ser positiva" << endl;
+        return 1;
     }
-};
 
-// ==================== CLASE: DERIVADOR DE ORDEN SUPERIOR ====================
-class DerivadorSuperior {
-private:
-    double z0, z1, z2, z3;  // Estados del derivador
-    
-    double phi(int i, double error) {
-        // φi(e) = -λ[i] * L^(i+1) * |e|^((n-i)/(n+1)) * sign(e)
-        // donde n = 3 (orden del derivador)
-        double n = 3.0;
-        double lambda;
-        
-        switch(i) {
-            case 0: lambda = LAMBDA_0; break;
-            case 1: lambda = LAMBDA_1; break;
-            case 2: lambda = LAMBDA_2; break;
-            case 3: lambda = LAMBDA_3; break;
-            default: lambda = 1.0;
+    string senal = argumentos.obtener("senal", "escalon");
+    vector<TrabajoSimulacion> trabajos;
+    if (senal == "todas" || senal == "all") {
+        // Mismos parámetros y archivos que la opción 4 del menú
+        trabajos.push_back({"escalon", GeneradorSenal::ESCALON, 1.0, 0.5, "datos_hil.txt"});
+        trabajos.push_back({"rampa", GeneradorSenal::RAMPA, 0.1, 0.5, "datos_rampa.txt"});
+        trabajos.push_back({"senoidal", GeneradorSenal::SENOIDAL, 1.0, 0.5, "datos_senoidal.txt"});
+    } else {
+        GeneradorSenal::TipoSenal tipo;
+        if (!interpretarSenal(senal, tipo)) {
+            cerr << "Error: Señal desconocida: " << senal << " (escalon, rampa, senoidal o todas)" << endl;
+            return 1;
         }
-        
-        double exponente = (n - i) / (n + 1.0);
-        double potencia_L = pow(L, i + 1);
-        
-        return -lambda * potencia_L * pow(abs(error), exponente) * signo(error);
+        double amplitud = 1.0, frecuencia = 0.5;
+        if (!argumentos.obtener_real("amplitud", amplitud) || !argumentos.obtener_real("frecuencia", frecuencia)) {
+            return 1;
+        }
+        trabajos.push_back({senal, tipo, amplitud, frecuencia, argumentos.obtener("salida", "datos_hil.txt")});
     }
 
-public:
-    DerivadorSuperior() : z0(0), z1(0), z2(0), z3(0) {}
-    
-    void actualizar(double referencia_f) {
-        double error = z0 - referencia_f;
-        
-        // Calcular phi para cada orden
-        double phi0 = phi(0, error);
-        double phi1 = phi(1, error);
-        double phi2 = phi(2, error);
-        double phi3 = phi(3, error);
-        
-        // Actualizar estados según ecuaciones (2)
-        double z0_nuevo = z0 + TAU_S * phi0 + TAU_S * z1 
-                          + (TAU_S * TAU_S / 2.0) * z2 
-                          + (TAU_S * TAU_S * TAU_S / 6.0) * z3;
-        
-        double z1_nuevo = z1 + TAU_S * phi1 + TAU_S * z2 
-                          + (TAU_S * TAU_S / 2.0) * z3;
-        
-        double z2_nuevo = z2 + TAU_S * phi2 + TAU_S * z3;
-        
-        double z3_nuevo = z3 + TAU_S * phi3;
-        
-        z0 = z0_nuevo;
-        z1 = z1_nuevo;
-        z2 = z2_nuevo;
-        z3 = z3_nuevo;
-    }
-    
-    double obtenerZ0() const { return z0; }
-    double obtenerZ1() const { return z1; }
-    double obtenerZ2() const { return z2; }
-    double obtenerZ3() const { return z3; }
-    
-    void reiniciar() {
-        z0 = z1 = z2 = z3 = 0.0;
+    // Comparación double / float / punto fijo en lugar de la simulación
+    if (argumentos.bandera("comparar-escalares")) {
+        for (const TrabajoSimulacion& t : trabajos) {
+            cout << "\n--- " << t.nombre << " ---";
+            compararTiposEscalares(t.tipo, duracion, t.amplitud, t.frecuencia);
+        }
+        return 0;
     }
-};
 
-// ==================== GENERADOR DE SEÑALES ====================
-class GeneradorSenal {
-public:
-    enum TipoSenal { ESCALON, RAMPA, SENOIDAL };
-    
-    static double generar(TipoSenal tipo, double tiempo_t, double amplitud = 1.0, double frecuencia = 0.5) {
-        switch(tipo) {
-            case ESCALON:
-                return amplitud;
-            
-            case RAMPA:
-                return amplitud * tiempo_t;
-            
-            case SENOIDAL:
-                return amplitud * sin(2.0 * M_PI * frecuencia * tiempo_t);
-            
-            default:
-                return 0.0;
+    // Monte Carlo con ruido en la referencia: los hilos reparten ensayos
+    if (argumentos.bandera("monte-carlo")) {
+        vector<CorridaMonteCarlo> corridas;
+        for (const TrabajoSimulacion& t : trabajos) {
+            CorridaMonteCarlo corrida;
+            corrida.senal = t.nombre;
+            ConfigMonteCarlo& cfg = corrida.config;
+            cfg.senal = t.tipo;
+            cfg.duracion = duracion;
+            cfg.amplitud = t.amplitud;
+            cfg.frecuencia = t.frecuencia;
+            if (!interpretarRuido(argumentos.obtener("ruido", "gaussiano"), cfg.ruido)) {
+                cerr << "Error: Ruido desconocido: " << argumentos.obtener("ruido")
+                     << " (gaussiano, uniforme, cuantizacion o atipicos)" << endl;
+                return 1;
+            }
+            if (!argumentos.obtener_real("nivel", cfg.nivel)
+                || !argumentos.obtener_real("prob-atipico", cfg.prob_atipico)
+                || !argumentos.obtener_real("magnitud-atipico", cfg.magnitud_atipico)
+                || !argumentos.obtener_real("transitorio", cfg.transitorio)
+                || !argumentos.obtener_entero("ensayos", cfg.ensayos)
+                || !argumentos.obtener_entero("hilos", cfg.hilos)) {
+                return 1;
+            }
+            cfg.semilla = strtoull(argumentos.obtener("semilla", to_string(cfg.semilla)).c_str(), nullptr, 10);
+            corrida.resultado = ejecutarMonteCarlo(cfg);
+            corridas.push_back(corrida);
         }
+        mostrarMonteCarlo(corridas, formato);
+        return 0;
     }
-};
 
-// ==================== SIMULACIÓN HIL ====================
-class SimulacionHIL {
-private:
-    PlantaG planta;
-    DerivadorSuperior derivador;
-    ofstream archivo_datos;
-    
-    string nombre_archivo;
-    double tiempo_actual;
-    int numero_muestras;
+    // Con varias simulaciones en paralelo los mensajes se mezclarían:
+    // solo se muestran en la ejecución secuencial
+    int hilos = 1;
+    if (!argumentos.obtener_entero("hilos", hilos)) return 1;
+    if (hilos <= 0) hilos = max(1u, thread::hardware_concurrency());
+    bool paralelo = hilos > 1 && trabajos.size() > 1;
 
-public:
-    SimulacionHIL(const string& nombre = "datos_hil.txt") 
-        : nombre_archivo(nombre), tiempo_actual(0.0), numero_muestras(0) {
+    vector<unique_ptr<SimulacionHIL>> simulaciones;
+    for (const TrabajoSimulacion& t : trabajos) {
+        simulaciones.emplace_back(new SimulacionHIL(t.archivo));
+        simulaciones.back()->establecerSilencioso(silencioso || paralelo || formato != SALIDA_TEXTO);
+        simulaciones.back()->iniciar();
+        if (!simulaciones.back()->abierto()) return 1;
     }
-    
-    void iniciar() {
-        archivo_datos.open(nombre_archivo);
-        if (!archivo_datos.is_open()) {
-            cerr << "Error al abrir el archivo " << nombre_archivo << endl;
-            return;
-        }
-        
-        // Escribir encabezado
-        archivo_datos << fixed << setprecision(6);
-        archivo_datos << "Tiempo,Referencia,Entrada_Planta,Salida_Planta,z0,z1,z2,z3\n";
-        
-        planta.reiniciar();
-        derivador.reiniciar();
-        tiempo_actual = 0.0;
-        numero_muestras = 0;
+
+    auto correr = [&](size_t i) {
+        simulaciones[i]->simular(trabajos[i].tipo, duracion, trabajos[i].amplitud, trabajos[i].frecuencia);
+        simulaciones[i]->finalizar();
+    };
+
+    if (paralelo) {
+        vector<thread> trabajadores;
+        for (size_t i = 0; i < trabajos.size(); ++i) trabajadores.emplace_back(correr, i);
+        for (thread& t : trabajadores) t.join();
+    } else {
+        for (size_t i = 0; i < trabajos.size(); ++i) correr(i);
     }
-    
-    void simular(GeneradorSenal::TipoSenal tipo, double duracion, 
-                 double amplitud = 1.0, double frecuencia = 0.5) {
-        
-        cout << "\n========================================\n";
-        cout << "   SIMULACIÓN HARDWARE IN THE LOOP\n";
-        cout << "========================================\n\n";
-        
-        string nombre_senal;
-        switch(tipo) {
-            case GeneradorSenal::ESCALON: nombre_senal = "Escalón"; break;
-            case GeneradorSenal::RAMPA: nombre_senal = "Rampa"; break;
-            case GeneradorSenal::SENOIDAL: nombre_senal = "Senoidal"; break;
-        }
-        
-        cout << "Tipo de señal: " << nombre_senal << endl;
-        cout << "Amplitud: " << amplitud << endl;
-        if (tipo == GeneradorSenal::SENOIDAL) {
-            cout << "Frecuencia: " << frecuencia << " Hz" << endl;
-        }
-        cout << "Duración: " << duracion << " segundos" << endl;
-        cout << "Frecuencia de muestreo: 250 Hz" << endl;
-        cout << "\nSimulando";
-        
-        int total_muestras = static_cast<int>(duracion / TAU_S);
-        auto inicio = chrono::high_resolution_clock::now();
-        
-        for (int k = 0; k < total_muestras; ++k) {
-            // Generar señal de referencia
-            double senal_referencia = GeneradorSenal::generar(tipo, tiempo_actual, amplitud, frecuencia);
-            
-            // Actualizar derivador con la referencia
-            derivador.actualizar(senal_referencia);
-            
-            // La entrada a la planta puede ser la referencia o una señal de control
-            // Para este ejemplo, usamos la referencia directamente
-            double entrada_planta = senal_referencia;
-            
-            // Actualizar planta
-            double salida_planta = planta.actualizar(entrada_planta);
-            
-            // Guardar datos
-            archivo_datos << tiempo_actual << ","
-                         << senal_referencia << ","
-                         << entrada_planta << ","
-                         << salida_planta << ","
-                         << derivador.obtenerZ0() << ","
-                         << derivador.obtenerZ1() << ","
-                         << derivador.obtenerZ2() << ","
-                         << derivador.obtenerZ3() << "\n";
-            
-            // Avanzar tiempo
-            tiempo_actual += TAU_S;
-            numero_muestras++;
-            
-            // Mostrar progreso cada 10%
-            if (k % (total_muestras / 10) == 0) {
-                cout << ".";
-                cout.flush();
-            }
-            
-            // Simulación en tiempo real (opcional, comentar para simulación rápida)
-            // this_thread::sleep_for(chrono::microseconds(4000));
-        }
-        
-        auto fin = chrono::high_resolution_clock::now();
-        auto duracion_sim = chrono::duration_cast<chrono::milliseconds>(fin - inicio);
-        
-        cout << " ¡Completo!\n\n";
-        cout << "Muestras procesadas: " << numero_muestras << endl;
-        cout << "Tiempo de simulación: " << duracion_sim.count() / 1000.0 << " segundos" << endl;
-        cout << "Datos guardados en: " << nombre_archivo << endl;
+
+    // Resumen por simulación
+    if (formato == SALIDA_CSV) {
+        cout << "senal,muestras,segundos,archivo\n";
+    } else if (formato == SALIDA_JSON) {
+        cout << "[\n";
     }
-    
-    void finalizar() {
-        if (archivo_datos.is_open()) {
-            archivo_datos.close();
+    for (size_t i = 0; i < trabajos.size(); ++i) {
+        const SimulacionHIL& s = *simulaciones[i];
+        cout << fixed << setprecision(4);
+        if (formato == SALIDA_CSV) {
+            cout << trabajos[i].nombre << "," << s.obtenerMuestras() << "," << s.obtenerSegundos()
+                 << "," << s.obtenerArchivo() << "\n";
+        } else if (formato == SALIDA_JSON) {
+            cout << "  {\"senal\": \"" << trabajos[i].nombre << "\", \"muestras\": " << s.obtenerMuestras()
+                 << ", \"segundos\": " << s.obtenerSegundos() << ", \"archivo\": \"" << s.obtenerArchivo()
+                 << "\"}" << (i + 1 < trabajos.size() ? "," : "") << "\n";
+        } else if (silencioso || paralelo) {
+            cout << trabajos[i].nombre << ": " << s.obtenerMuestras() << " muestras en "
+                 << s.obtenerSegundos() << " s -> " << s.obtenerArchivo() << "\n";
         }
     }
-    
-    ~SimulacionHIL() {
-        finalizar();
-    }
-};
+    if (formato == SALIDA_JSON) cout << "]\n";
+    return 0;
+}
 
 // ==================== MENÚ PRINCIPAL ====================
 void mostrarMenu() {
@@ -301,20 +239,98 @@ void mostrarMenu() {
     cout << "2. Simular con señal Rampa\n";
     cout << "3. Simular con señal Senoidal\n";
     cout << "4. Simular múltiples señales\n";
-    cout << "5. Salir\n\n";
+    cout << "5. Comparar double, float y punto fijo\n";
+    cout << "6. Monte Carlo con ruido de medición\n";
+    cout << "7. Salir\n\n";
     cout << "Seleccione una opción: ";
 }
 
-int main() {
+int main(int argc, char* argv[]) {
 
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
+#endif
+
+    Argumentos argumentos({
+        {"senal", "signal", true, "escalon, rampa, senoidal o todas"},
+        {"amplitud", "amplitude", true, "Amplitud (o pendiente de la rampa), por defecto 1"},
+        {"frecuencia", "frequency", true, "Frecuencia de la senoidal en Hz, por defecto 0.5"},
+        {"duracion", "duration", true, "Duración en segundos, por defecto 10"},
+        {"salida", "output", true, "Archivo de datos (por defecto datos_hil.txt)"},
+        {"hilos", "threads", true, "Hilos para simular \"todas\" en paralelo (0 = todos los núcleos)"},
+        {"silencioso", "quiet", false, "Sin encabezado ni progreso"},
+        {"formato-salida", "output-format", true, "Resumen en texto, csv o json"},
+        {"comparar-escalares", "compare-scalars", false, "Compara double, float y punto fijo en lugar de simular"},
+        {"monte-carlo", "", false, "Ensayos con ruido en la referencia en lugar de simular"},
+        {"ruido", "noise", true, "gaussiano, uniforme, cuantizacion o atipicos"},
+        {"nivel", "level", true, "Desviación, semiancho o paso de cuantización (por defecto 0.01)"},
+        {"prob-atipico", "outlier-prob", true, "Probabilidad de atípico por muestra (por defecto 0.01)"},
+        {"magnitud-atipico", "outlier-size", true, "Magnitud de los atípicos (por defecto 1)"},
+        {"transitorio", "warmup", true, "Segundos iniciales sin estadísticas (por defecto 1)"},
+        {"ensayos", "trials", true, "Ensayos Monte Carlo (por defecto 1000)"},
+        {"semilla", "seed", true, "Semilla de los flujos aleatorios (por defecto 2025)"},
+    });
+    if (!argumentos.analizar(argc, argv)) return 1;
+    if (argumentos.bandera("ayuda")) {
+        argumentos.mostrar_ayuda("eje_2", "Simulador HIL. Sin opciones se muestra el menú interactivo.");
+        return 0;
+    }
+    if (argumentos.hay_opciones()) {
+        int codigo = ejecutarLotes(argumentos);
+        INSTRUMENTAR_FINALIZAR("eje_2");
+        return codigo;
+    }
 
     int opcion;
     double duracion, amplitud, frecuencia;
     
     do {
         mostrarMenu();
-        cin >> opcion;
+        if (!(cin >> opcion)) break;
+        
+        if (opcion == 5) {
+            int tipo;
+            cout << "\nSeñal (1 = Escalón, 2 = Rampa, 3 = Senoidal): ";
+            cin >> tipo;
+            cout << "Ingrese duración (segundos): ";
+            cin >> duracion;
+            if (tipo == 2) {
+                compararTiposEscalares(GeneradorSenal::RAMPA, duracion, 0.1);
+            } else if (tipo == 3) {
+                compararTiposEscalares(GeneradorSenal::SENOIDAL, duracion, 1.0, 0.5);
+            } else {
+                compararTiposEscalares(GeneradorSenal::ESCALON, duracion, 1.0);
+            }
+            
+            cout << "\nPresione Enter para continuar...";
+            cin.ignore();
+            cin.get();
+        }
+        
+        if (opcion == 6) {
+            ConfigMonteCarlo config;
+            int tipo, ruido;
+            cout << "\nSeñal (1 = Escalón, 2 = Rampa, 3 = Senoidal): ";
+            cin >> tipo;
+            cout << "Ruido (1 = Gaussiano, 2 = Uniforme, 3 = Cuantización, 4 = Atípicos): ";
+            cin >> ruido;
+            cout << "Nivel (desviación, semiancho o paso): ";
+            cin >> config.nivel;
+            cout << "Número de ensayos: ";
+            cin >> config.ensayos;
+            
+            config.senal = tipo == 2 ? GeneradorSenal::RAMPA : tipo == 3 ? GeneradorSenal::SENOIDAL : GeneradorSenal::ESCALON;
+            config.amplitud = tipo == 2 ? 0.1 : 1.0;
+            config.ruido = ruido == 2 ? RUIDO_UNIFORME : ruido == 3 ? RUIDO_CUANTIZACION
+                         : ruido == 4 ? RUIDO_ATIPICOS : RUIDO_GAUSSIANO;
+            
+            const char* nombres[] = {"Escalón", "Rampa", "Senoidal"};
+            mostrarMonteCarlo({{nombres[config.senal], config, ejecutarMonteCarlo(config)}}, SALIDA_TEXTO);
+            
+            cout << "\nPresione Enter para continuar...";
+            cin.ignore();
+            cin.get();
+        }
         
         if (opcion >= 1 && opcion <= 4) {
             SimulacionHIL simulador;
@@ -377,8 +393,9 @@ int main() {
             cin.get();
         }
         
-    } while (opcion != 5);
+    } while (opcion != 7);
     
     cout << "\n¡Hasta luego!\n";
+    INSTRUMENTAR_FINALIZAR("eje_2");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,239 @@
+// ============================================================================
+// SIMULACIÓN HIL - BIBLIOTECA
+// ============================================================================
+// Planta SISO discretizada, derivador de orden superior, generador de
+// señales y el ciclo de simulación. El menú interactivo está en eje_2.cpp.
+// ============================================================================
+
+#ifndef HIL_H
+#define HIL_H
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <fstream>
+#include <algorithm>
+#include "punto_fijo.h"
+using namespace std;
+
+// ==================== CONSTANTES ====================
+const double TAU_S = 0.004;      // Tiempo de muestreo (250 Hz)
+const double L = 1.8;            // Constante de Lipschitz
+const double LAMBDA_0 = 1.3;
+const double LAMBDA_1 = 1.85;
+const double LAMBDA_2 = 2.79;
+const double LAMBDA_3 = 6.48;
+
+// ==================== FUNCIONES AUXILIARES ====================
+// La planta, el derivador y el generador son plantillas sobre el tipo
+// escalar (double, float o PuntoFijo<F> de punto_fijo.h); estas funciones
+// dan a los tres la misma interfaz. Las versiones de punto fijo están en
+// punto_fijo.h.
+template <typename T>
+T signo(T x) {
+    if (x > T(0)) return T(1);
+    if (x < T(0)) return T(-1);
+    return T(0);
+}
+
+inline double raiz(double x) { return sqrt(x); }
+inline float raiz(float x) { return sqrt(x); }
+inline double seno(double x) { return sin(x); }
+inline float seno(float x) { return sin(x); }
+
+// ==================== CLASE: PLANTA SISO ====================
+template <typename T>
+class PlantaGGenerica {
+private:
+    // Coeficientes de la función de transferencia
+    // G(s) = (7s^2 - 28s + 21) / (s^3 + 9.8s^2 + 30.65s + 30.1)
+    
+    // Estados discretizados usando método Tustin (bilinear)
+    vector<T> estados_x;  // Estados de la planta
+    vector<T> historial_u;  // Historial de entradas
+    vector<T> historial_y;  // Historial de salidas
+    
+    // Coeficientes discretizados (Tustin con Ts = 0.004)
+    T a0, a1, a2, a3;  // Denominador
+    T b0, b1, b2, b3;  // Numerador
+
+public:
+    PlantaGGenerica() {
+        // Inicialización de estados
+        estados_x.resize(3, T(0));
+        historial_u.resize(3, T(0));
+        historial_y.resize(3, T(0));
+        
+        // Discretización usando Tustin (aproximación)
+        // Estos coeficientes se calculan a partir de c2d en MATLAB/Python
+        // Para simplificar, usamos una aproximación de la respuesta al escalón
+        
+        // Coeficientes aproximados para Ts = 0.004
+        a0 = T(1.0);
+        a1 = T(-2.88232);
+        a2 = T(2.76606);
+        a3 = T(-0.88371);
+        
+        b0 = T(0.00002334);
+        b1 = T(-0.00004668);
+        b2 = T(0.00002334);
+        b3 = T(0.0);
+    }
+    
+    T actualizar(T entrada_u) {
+        // Ecuación en diferencias de 3er orden
+        // y[k] = -a1*y[k-1] - a2*y[k-2] - a3*y[k-3] + b0*u[k] + b1*u[k-1] + b2*u[k-2]
+        
+        T salida_y = -a1 * historial_y[0] - a2 * historial_y[1] - a3 * historial_y[2]
+                     + b0 * entrada_u + b1 * historial_u[0] + b2 * historial_u[1];
+        
+        // Actualizar historiales
+        historial_y[2] = historial_y[1];
+        historial_y[1] = historial_y[0];
+        historial_y[0] = salida_y;
+        
+        historial_u[2] = historial_u[1];
+        historial_u[1] = historial_u[0];
+        historial_u[0] = entrada_u;
+        
+        return salida_y;
+    }
+    
+    void reiniciar() {
+        fill(estados_x.begin(), estados_x.end(), T(0));
+        fill(historial_u.begin(), historial_u.end(), T(0));
+        fill(historial_y.begin(), historial_y.end(), T(0));
+    }
+};
+
+// ==================== CLASE: DERIVADOR DE ORDEN SUPERIOR ====================
+template <typename T>
+class DerivadorSuperiorGenerico {
+private:
+    T z0, z1, z2, z3;  // Estados del derivador
+    
+    // φi(e) = -λ[i] * L^(i+1) * |e|^((n-i)/(n+1)) * sign(e), con n = 3.
+    // Las ganancias λ[i] * L^(i+1) se calculan una vez; los exponentes
+    // 3/4, 1/2, 1/4 y 0 salen de dos raíces cuadradas (sin pow, que no
+    // existe en punto fijo y es mucho más cara)
+    T ganancia[4];
+    
+    // Paso de Taylor en forma de Horner: Ts, Ts/2 y Ts/3 en lugar de
+    // Ts^2/2 y Ts^3/6, que en punto fijo quedarían por debajo de la resolución
+    T tau, tau_medio, tau_tercio;
+
+public:
+    DerivadorSuperiorGenerico()
+        : z0(0), z1(0), z2(0), z3(0),
+          tau(TAU_S), tau_medio(TAU_S / 2.0), tau_tercio(TAU_S / 3.0) {
+        const double lambda[4] = {LAMBDA_0, LAMBDA_1, LAMBDA_2, LAMBDA_3};
+        for (int i = 0; i < 4; ++i) ganancia[i] = T(lambda[i] * pow(L, i + 1));
+    }
+    
+    void actualizar(T referencia_f) {
+        T error = z0 - referencia_f;
+        
+        // Calcular phi para cada orden
+        T magnitud = error < T(0) ? -error : error;
+        T raiz_2 = raiz(magnitud);     // |e|^(1/2)
+        T raiz_4 = raiz(raiz_2);       // |e|^(1/4)
+        T s = signo(error);
+        
+        T phi0 = -ganancia[0] * (raiz_2 * raiz_4) * s;
+        T phi1 = -ganancia[1] * raiz_2 * s;
+        T phi2 = -ganancia[2] * raiz_4 * s;
+        T phi3 = -ganancia[3] * s;
+        
+        // Actualizar estados según ecuaciones (2):
+        // z0 + Ts*phi0 + Ts*z1 + Ts^2/2*z2 + Ts^3/6*z3, etc.
+        T z0_nuevo = z0 + tau * (phi0 + z1 + tau_medio * (z2 + tau_tercio * z3));
+        
+        T z1_nuevo = z1 + tau * (phi1 + z2 + tau_medio * z3);
+        
+        T z2_nuevo = z2 + tau * (phi2 + z3);
+        
+        T z3_nuevo = z3 + tau * phi3;
+        
+        z0 = z0_nuevo;
+        z1 = z1_nuevo;
+        z2 = z2_nuevo;
+        z3 = z3_nuevo;
+    }
+    
+    T obtenerZ0() const { return z0; }
+    T obtenerZ1() const { return z1; }
+    T obtenerZ2() const { return z2; }
+    T obtenerZ3() const { return z3; }
+    
+    void reiniciar() {
+        z0 = z1 = z2 = z3 = T(0);
+    }
+};
+
+using PlantaG = PlantaGGenerica<double>;
+using DerivadorSuperior = DerivadorSuperiorGenerico<double>;
+
+// ==================== GENERADOR DE SEÑALES ====================
+class GeneradorSenal {
+public:
+    enum TipoSenal { ESCALON, RAMPA, SENOIDAL };
+    
+    template <typename T = double>
+    static T generar(TipoSenal tipo, T tiempo_t, T amplitud = T(1.0), T frecuencia = T(0.5)) {
+        switch(tipo) {
+            case ESCALON:
+                return amplitud;
+            
+            case RAMPA:
+                return amplitud * tiempo_t;
+            
+            case SENOIDAL:
+                return amplitud * seno(T(2.0 * M_PI) * frecuencia * tiempo_t);
+            
+            default:
+                return T(0);
+        }
+    }
+};
+
+// ==================== COMPARACIÓN DE TIPOS ESCALARES ====================
+// Simula la misma señal con double (referencia), float y punto fijo Q15.16
+// y Q7.24, y reporta el costo por paso (generador + derivador + planta, sin
+// escritura) y la desviación máxima y RMS de Salida_Planta y z0..z3 frente
+// a double. Estima el throughput y la precisión en un microcontrolador.
+void compararTiposEscalares(GeneradorSenal::TipoSenal tipo, double duracion,
+                            double amplitud = 1.0, double frecuencia = 0.5);
+
+// ==================== SIMULACIÓN HIL ====================
+class SimulacionHIL {
+private:
+    PlantaG planta;
+    DerivadorSuperior derivador;
+    ofstream archivo_datos;
+    
+    string nombre_archivo;
+    double tiempo_actual;
+    int numero_muestras;
+    bool silencioso;            // Sin encabezado ni progreso en consola
+    double segundos_simulacion; // Tiempo real de la última simulación
+
+public:
+    SimulacionHIL(const string& nombre = "datos_hil.txt");
+    
+    void iniciar();
+    
+    void simular(GeneradorSenal::TipoSenal tipo, double duracion, 
+                 double amplitud = 1.0, double frecuencia = 0.5);
+    
+    void finalizar();
+
+    void establecerSilencioso(bool valor) { silencioso = valor; }
+    bool abierto() const { return archivo_datos.is_open(); }
+    int obtenerMuestras() const { return numero_muestras; }
+    double obtenerSegundos() const { return segundos_simulacion; }
+    const string& obtenerArchivo() const { return nombre_archivo; }
+    
+    ~SimulacionHIL();
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "monte_carlo.h"
+#include "instrumentacion.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+using namespace std;
+
+// ==================== CONFIGURACIÓN ====================
+bool interpretarRuido(const string& texto, TipoRuido& ruido) {
+    if (texto == "gaussiano" || texto == "gaussian") ruido = RUIDO_GAUSSIANO;
+    else if (texto == "uniforme" || texto == "uniform") ruido = RUIDO_UNIFORME;
+    else if (texto == "cuantizacion" || texto == "cuantización" || texto == "quantization") ruido = RUIDO_CUANTIZACION;
+    else if (texto == "atipicos" || texto == "atípicos" || texto == "outliers") ruido = RUIDO_ATIPICOS;
+    else return false;
+    return true;
+}
+
+string nombreRuido(TipoRuido ruido) {
+    switch (ruido) {
+        case RUIDO_GAUSSIANO: return "gaussiano";
+        case RUIDO_UNIFORME: return "uniforme";
+        case RUIDO_CUANTIZACION: return "cuantizacion";
+        case RUIDO_ATIPICOS: return "atipicos";
+    }
+    return "desconocido";
+}
+
+// ==================== ENSAYO ====================
+namespace {
+
+// Contadores por paso del flujo aleatorio: dos uniformes para Box-Muller
+// o para probabilidad y signo del atípico
+const uint64_t SORTEOS_POR_PASO = 2;
+
+// Primera derivada analítica de la señal limpia
+double derivadaReferencia(GeneradorSenal::TipoSenal tipo, double t, double amplitud, double frecuencia) {
+    switch (tipo) {
+        case GeneradorSenal::ESCALON: return 0.0;
+        case GeneradorSenal::RAMPA: return amplitud;
+        case GeneradorSenal::SENOIDAL: {
+            double omega = 2.0 * M_PI * frecuencia;
+            return amplitud * omega * cos(omega * t);
+        }
+    }
+    return 0.0;
+}
+
+double medirConRuido(const ConfigMonteCarlo& config, const FlujoAleatorio& flujo, double desfase,
+                     double limpia, uint64_t paso) {
+    uint64_t contador = paso * SORTEOS_POR_PASO;
+    switch (config.ruido) {
+        case RUIDO_GAUSSIANO: {
+            double u1 = flujo.uniforme(contador), u2 = flujo.uniforme(contador + 1);
+            return limpia + config.nivel * sqrt(-2.0 * log(u1)) * cos(2.0 * M_PI * u2);
+        }
+        case RUIDO_UNIFORME:
+            return limpia + config.nivel * (2.0 * flujo.uniforme(contador) - 1.0);
+        case RUIDO_CUANTIZACION:
+            return config.nivel > 0 ? config.nivel * round((limpia + desfase) / config.nivel) : limpia;
+        case RUIDO_ATIPICOS:
+            if (flujo.uniforme(contador) <= config.prob_atipico) {
+                return limpia + (flujo.entero(contador + 1) & 1 ? config.magnitud_atipico : -config.magnitud_atipico);
+            }
+            return limpia;
+    }
+    return limpia;
+}
+
+struct ResumenEnsayo {
+    EstadisticaWelford error[ORDENES_MONTE_CARLO];
+};
+
+ResumenEnsayo simularEnsayo(const ConfigMonteCarlo& config, int ensayo) {
+    ResumenEnsayo resumen;
+    FlujoAleatorio flujo(config.semilla, static_cast<uint64_t>(ensayo));
+
+    // Desfase del conversor, fijo durante el ensayo (contador fuera del rango de pasos)
+    double desfase = config.nivel * (flujo.uniforme(~uint64_t(0) - 1) - 0.5);
+
+    DerivadorSuperior derivador;
+    int total_muestras = static_cast<int>(config.duracion / TAU_S);
+    int inicio_estadisticas = static_cast<int>(config.transitorio / TAU_S);
+
+    for (int k = 0; k < total_muestras; ++k) {
+        double t = k * TAU_S;
+        double limpia = GeneradorSenal::generar(config.senal, t, config.amplitud, config.frecuencia);
+        derivador.actualizar(medirConRuido(config, flujo, desfase, limpia, static_cast<uint64_t>(k)));
+
+        if (k < inicio_estadisticas) continue;
+        resumen.error[0].agregar(derivador.obtenerZ0() - limpia);
+        resumen.error[1].agregar(derivador.obtenerZ1()
+                                 - derivadaReferencia(config.senal, t, config.amplitud, config.frecuencia));
+    }
+    return resumen;
+}
+
+} // namespace
+
+// ==================== EJECUCIÓN EN PARALELO ====================
+ResultadoMonteCarlo ejecutarMonteCarlo(const ConfigMonteCarlo& config) {
+    INSTRUMENTAR_AMBITO("hil.monte_carlo");
+
+    ResultadoMonteCarlo resultado;
+    resultado.ensayos = max(0, config.ensayos);
+    int hilos = config.hilos > 0 ? config.hilos : static_cast<int>(max(1u, thread::hardware_concurrency()));
+    hilos = max(1, min(hilos, resultado.ensayos));
+    resultado.hilos = hilos;
+
+    // Solo un resumen por ensayo (dos acumuladores), nunca la traza
+    vector<ResumenEnsayo> resumenes(resultado.ensayos);
+    atomic<int> siguiente(0);
+    auto trabajar = [&]() {
+        for (int i = siguiente++; i < resultado.ensayos; i = siguiente++) {
+            resumenes[i] = simularEnsayo(config, i);
+        }
+    };
+
+    // Línea base sin ruido: separa el error propio del derivador (su
+    // vibración en modo deslizante) del que agrega el ruido
+    ConfigMonteCarlo limpio = config;
+    limpio.nivel = 0.0;
+    limpio.prob_atipico = 0.0;
+    ResumenEnsayo base = simularEnsayo(limpio, 0);
+    for (int o = 0; o < ORDENES_MONTE_CARLO; ++o) resultado.sin_ruido[o] = base.error[o];
+
+    auto inicio = chrono::high_resolution_clock::now();
+    vector<thread> trabajadores;
+    for (int h = 1; h < hilos; ++h) trabajadores.emplace_back(trabajar);
+    trabajar();
+    for (thread& t : trabajadores) t.join();
+
+    // Combinación en orden de ensayo: misma suma en coma flotante con
+    // cualquier número de hilos
+    for (const ResumenEnsayo& r : resumenes) {
+        for (int o = 0; o < ORDENES_MONTE_CARLO; ++o) {
+            resultado.error[o].combinar(r.error[o]);
+            resultado.rms_ensayo[o].agregar(r.error[o].rms());
+        }
+    }
+    resultado.segundos = chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+    return resultado;
+}
@@ -0,0 +1,123 @@
+// ============================================================================
+// SIMULACIÓN HIL - MONTE CARLO CON RUIDO DE MEDICIÓN
+// ============================================================================
+// Robustez del derivador ante ruido en la referencia: miles de ensayos
+// independientes, cada uno con su propio flujo aleatorio, en paralelo.
+// ============================================================================
+
+#ifndef MONTE_CARLO_H
+#define MONTE_CARLO_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "hil.h"
+
+using namespace std;
+
+// ==================== NÚMEROS ALEATORIOS POR CONTADOR ====================
+// El valor aleatorio depende solo de (semilla, ensayo, contador), no del
+// orden en que se piden: cada ensayo se puede simular en cualquier hilo y
+// el resultado es el mismo con 1 o con N hilos. Función de mezcla de
+// SplitMix64.
+inline uint64_t mezclar64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+class FlujoAleatorio {
+private:
+    uint64_t clave;
+
+public:
+    FlujoAleatorio(uint64_t semilla, uint64_t ensayo) : clave(mezclar64(semilla ^ mezclar64(ensayo))) {}
+
+    uint64_t entero(uint64_t contador) const {
+        return mezclar64(clave + contador * 0xD1B54A32D192ED03ull);
+    }
+
+    // Uniforme en (0, 1]: nunca 0, para el logaritmo de Box-Muller
+    double uniforme(uint64_t contador) const {
+        return ((entero(contador) >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+};
+
+// ==================== CONFIGURACIÓN ====================
+enum TipoRuido {
+    RUIDO_GAUSSIANO,      // nivel = desviación estándar
+    RUIDO_UNIFORME,       // nivel = semiancho del intervalo [-nivel, nivel]
+    RUIDO_CUANTIZACION,   // nivel = paso del conversor; desfase aleatorio por ensayo
+    RUIDO_ATIPICOS        // Con probabilidad prob_atipico se suma ±magnitud_atipico
+};
+
+struct ConfigMonteCarlo {
+    GeneradorSenal::TipoSenal senal = GeneradorSenal::SENOIDAL;
+    double duracion = 10.0;
+    double amplitud = 1.0;
+    double frecuencia = 0.5;
+    TipoRuido ruido = RUIDO_GAUSSIANO;
+    double nivel = 0.01;
+    double prob_atipico = 0.01;
+    double magnitud_atipico = 1.0;
+    double transitorio = 1.0;     // Segundos iniciales excluidos de las estadísticas
+    int ensayos = 1000;
+    int hilos = 0;                // 0 = hardware_concurrency()
+    uint64_t semilla = 2025;
+};
+
+bool interpretarRuido(const string& texto, TipoRuido& ruido);
+string nombreRuido(TipoRuido ruido);
+
+// ==================== ESTADÍSTICAS ====================
+// Media y varianza en una pasada (Welford); dos acumuladores se combinan
+// con la fórmula de Chan, así no hace falta guardar las trazas
+struct EstadisticaWelford {
+    uint64_t n = 0;
+    double media = 0.0;
+    double m2 = 0.0;
+    double maximo_abs = 0.0;
+
+    void agregar(double x) {
+        n++;
+        double delta = x - media;
+        media += delta / n;
+        m2 += delta * (x - media);
+        if (fabs(x) > maximo_abs) maximo_abs = fabs(x);
+    }
+
+    void combinar(const EstadisticaWelford& o) {
+        if (o.n == 0) return;
+        uint64_t total = n + o.n;
+        double delta = o.media - media;
+        media += delta * o.n / total;
+        m2 += o.m2 + delta * delta * (static_cast<double>(n) * o.n / total);
+        n = total;
+        if (o.maximo_abs > maximo_abs) maximo_abs = o.maximo_abs;
+    }
+
+    double varianza() const { return n > 1 ? m2 / n : 0.0; }
+    double desviacion() const { return sqrt(varianza()); }
+    double rms() const { return sqrt(varianza() + media * media); }
+};
+
+// Derivadas comparadas: z0 frente a la señal limpia y z1 frente a su
+// derivada analítica
+const int ORDENES_MONTE_CARLO = 2;
+
+struct ResultadoMonteCarlo {
+    EstadisticaWelford error[ORDENES_MONTE_CARLO];       // Todas las muestras de todos los ensayos
+    EstadisticaWelford rms_ensayo[ORDENES_MONTE_CARLO];  // RMS de cada ensayo, entre ensayos
+    EstadisticaWelford sin_ruido[ORDENES_MONTE_CARLO];   // Mismo ensayo con la referencia limpia
+    int ensayos = 0;
+    int hilos = 0;
+    double segundos = 0.0;
+};
+
+// Ejecuta los ensayos repartidos entre hilos. Cada ensayo guarda solo su
+// resumen; la combinación se hace en orden de ensayo, por lo que el
+// resultado no depende del número de hilos.
+ResultadoMonteCarlo ejecutarMonteCarlo(const ConfigMonteCarlo& config);
+
+#endif
@@ -0,0 +1,133 @@
+// ============================================================================
+// SIMULACIÓN HIL - ARITMÉTICA EN PUNTO FIJO
+// ============================================================================
+// Escalar Q(31-F).F en un entero de 32 bits, como en un microcontrolador sin
+// unidad de coma flotante: productos en 64 bits con redondeo y saturación
+// en lugar de desbordamiento. Raíz cuadrada entera y seno polinomial, sin
+// pasar por double, para que la planta y el derivador se puedan instanciar
+// con este tipo (ver hil.h).
+// ============================================================================
+
+#ifndef PUNTO_FIJO_H
+#define PUNTO_FIJO_H
+
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+template <int FRACCION>
+class PuntoFijo {
+private:
+    int32_t valor;   // Valor real * 2^FRACCION
+
+    static int32_t saturar(int64_t v) {
+        if (v > numeric_limits<int32_t>::max()) return numeric_limits<int32_t>::max();
+        if (v < numeric_limits<int32_t>::min()) return numeric_limits<int32_t>::min();
+        return static_cast<int32_t>(v);
+    }
+
+public:
+    static constexpr int64_t UNO = int64_t(1) << FRACCION;
+
+    PuntoFijo() : valor(0) {}
+
+    // Conversión desde double: solo para constantes y para leer resultados
+    explicit PuntoFijo(double x) {
+        double escalado = x * UNO;
+        if (escalado >= numeric_limits<int32_t>::max()) valor = numeric_limits<int32_t>::max();
+        else if (escalado <= numeric_limits<int32_t>::min()) valor = numeric_limits<int32_t>::min();
+        else valor = static_cast<int32_t>(llround(escalado));
+    }
+
+    static PuntoFijo desde_crudo(int64_t crudo) {
+        PuntoFijo p;
+        p.valor = saturar(crudo);
+        return p;
+    }
+
+    int32_t crudo() const { return valor; }
+    explicit operator double() const { return static_cast<double>(valor) / UNO; }
+
+    static string nombre() {
+        return "Q" + to_string(31 - FRACCION) + "." + to_string(FRACCION);
+    }
+
+    PuntoFijo operator+(PuntoFijo o) const { return desde_crudo(int64_t(valor) + o.valor); }
+    PuntoFijo operator-(PuntoFijo o) const { return desde_crudo(int64_t(valor) - o.valor); }
+    PuntoFijo operator-() const { return desde_crudo(-int64_t(valor)); }
+
+    // Producto de 64 bits redondeado al bit menos significativo
+    PuntoFijo operator*(PuntoFijo o) const {
+        int64_t producto = int64_t(valor) * o.valor;
+        return desde_crudo((producto + (int64_t(1) << (FRACCION - 1))) >> FRACCION);
+    }
+
+    PuntoFijo& operator+=(PuntoFijo o) { return *this = *this + o; }
+    PuntoFijo& operator-=(PuntoFijo o) { return *this = *this - o; }
+
+    bool operator<(PuntoFijo o) const { return valor < o.valor; }
+    bool operator>(PuntoFijo o) const { return valor > o.valor; }
+    bool operator<=(PuntoFijo o) const { return valor <= o.valor; }
+    bool operator>=(PuntoFijo o) const { return valor >= o.valor; }
+    bool operator==(PuntoFijo o) const { return valor == o.valor; }
+    bool operator!=(PuntoFijo o) const { return valor != o.valor; }
+};
+
+using Q15_16 = PuntoFijo<16>;   // Rango ±32768, resolución 1.5e-5
+using Q7_24 = PuntoFijo<24>;    // Rango ±128, resolución 6e-8
+
+// ==================== RAÍZ CUADRADA ENTERA ====================
+// Método de dígito a dígito (base 4): solo sumas, restas y desplazamientos.
+// Empieza en la potencia de 4 más alta que no supera n
+inline uint64_t raiz_entera(uint64_t n) {
+    if (n == 0) return 0;
+    uint64_t resultado = 0;
+    uint64_t bit = uint64_t(1) << ((63 - __builtin_clzll(n)) & ~1);
+
+    // Sin saltos dependientes de los datos (el compilador usa cmov)
+    while (bit != 0) {
+        uint64_t candidato = resultado + bit;
+        bool cabe = n >= candidato;
+        n -= cabe ? candidato : 0;
+        resultado = (resultado >> 1) + (cabe ? bit : 0);
+        bit >>= 2;
+    }
+    return resultado;
+}
+
+// sqrt(v / 2^F) = sqrt(v * 2^F) / 2^F
+template <int F>
+PuntoFijo<F> raiz(PuntoFijo<F> x) {
+    if (x.crudo() <= 0) return PuntoFijo<F>();
+    return PuntoFijo<F>::desde_crudo(static_cast<int64_t>(raiz_entera(uint64_t(x.crudo()) << F)));
+}
+
+// ==================== SENO ====================
+// Reducción al intervalo [-π/2, π/2] con aritmética entera y serie de
+// Taylor hasta x^7 en Horner (error < 2e-4 en el extremo del intervalo)
+template <int F>
+PuntoFijo<F> seno(PuntoFijo<F> x) {
+    using T = PuntoFijo<F>;
+    constexpr int64_t PI_CRUDO = static_cast<int64_t>(M_PI * T::UNO + 0.5);
+    constexpr int64_t DOS_PI_CRUDO = static_cast<int64_t>(2.0 * M_PI * T::UNO + 0.5);
+    constexpr int64_t MEDIO_PI_CRUDO = static_cast<int64_t>(M_PI / 2.0 * T::UNO + 0.5);
+
+    int64_t r = x.crudo() % DOS_PI_CRUDO;
+    if (r > PI_CRUDO) r -= DOS_PI_CRUDO;
+    if (r < -PI_CRUDO) r += DOS_PI_CRUDO;
+    if (r > MEDIO_PI_CRUDO) r = PI_CRUDO - r;
+    else if (r < -MEDIO_PI_CRUDO) r = -PI_CRUDO - r;
+
+    T y = T::desde_crudo(r);
+    T y2 = y * y;
+    const T uno = T::desde_crudo(T::UNO);
+    const T sexto = T::desde_crudo(T::UNO / 6);
+    const T vigesimo = T::desde_crudo(T::UNO / 20);
+    const T cuadragesimo_segundo = T::desde_crudo(T::UNO / 42);
+    return y * (uno - y2 * sexto * (uno - y2 * vigesimo * (uno - y2 * cuadragesimo_segundo)));
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include "aumento.h"
+
+using namespace std;
+
+// ==================== GLIFO EMPAQUETADO ====================
+uint64_t empaquetar_glifo(const vector<double>& glifo) {
+    uint64_t bits = 0;
+    for (int p = 0; p < PIXELES_GLIFO; ++p) {
+        if (glifo[p] > 0.5) bits |= uint64_t(1) << p;
+    }
+    return bits;
+}
+
+// ==================== CONFIGURACIÓN ====================
+bool validar_config_aumento(const ConfigAumento& config) {
+    auto probabilidad = [](double p) { return p >= 0.0 && p <= 1.0; };
+    if (config.variantes < 1) {
+        cerr << "Error: --variantes debe ser >= 1\n";
+        return false;
+    }
+    if (!probabilidad(config.prob_inversion)) {
+        cerr << "Error: --prob-inversion debe estar en [0, 1]\n";
+        return false;
+    }
+    if (!probabilidad(config.prob_desplazamiento)) {
+        cerr << "Error: --prob-desplazamiento debe estar en [0, 1]\n";
+        return false;
+    }
+    if (!probabilidad(config.prob_engrosamiento)) {
+        cerr << "Error: --prob-engrosamiento debe estar en [0, 1]\n";
+        return false;
+    }
+    return true;
+}
+
+// ==================== ENTRENAMIENTO CON AUMENTO ====================
+ResultadoEntrenamiento entrenar_con_aumento(RedNeuronal& red, const vector<vector<double>>& glifos,
+                                            const vector<int>& etiquetas, const ConfigAumento& config,
+                                            const string& archivo_checkpoint) {
+    vector<vector<double>> objetivo_por_digito;
+    for (int numero = 0; numero < 10; ++numero) {
+        objetivo_por_digito.push_back(clases_a_vector(obtener_clases(numero)));
+    }
+
+    // Al reanudar, el flujo sigue con la semilla del checkpoint desde la
+    // primera variante no entrenada
+    ConfigAumento config_flujo = config;
+    uint64_t consumidos = red.obtener_variantes_consumidas();
+    if (consumidos > 0) {
+        if (red.obtener_semilla_aumento() != config.semilla) {
+            cerr << "Aviso: se reanuda el aumento con la semilla del checkpoint ("
+                 << red.obtener_semilla_aumento() << ")\n";
+        }
+        config_flujo.semilla = red.obtener_semilla_aumento();
+    }
+    red.registrar_aumento(config_flujo.semilla, consumidos);
+
+    ColaAumento cola(glifos, etiquetas, config_flujo, consumidos);
+    BloqueAumento* bloque = nullptr;
+    size_t posicion = 0;
+    uint64_t consumidos_ahora = 0;
+    size_t por_epoca = glifos.size() * static_cast<size_t>(config.variantes);
+
+    // El bloque en curso se conserva entre épocas: cada época continúa el
+    // flujo donde terminó la anterior. La posición se registra en la red
+    // antes de que entrenar_recorrido guarde el checkpoint de la época.
+    ResultadoEntrenamiento resultado = red.entrenar_recorrido([&](auto&& entrenar_patron) {
+        for (size_t k = 0; k < por_epoca; ++k) {
+            if (bloque == nullptr || posicion == bloque->cantidad) {
+                if (bloque != nullptr) cola.liberar(bloque);
+                bloque = cola.obtener();
+                posicion = 0;
+            }
+            entrenar_patron(bloque->glifos[posicion], objetivo_por_digito[bloque->etiquetas[posicion] % 10]);
+            ++posicion;
+        }
+        consumidos_ahora += por_epoca;
+        red.registrar_aumento(config_flujo.semilla, consumidos + consumidos_ahora);
+    }, archivo_checkpoint);
+    if (bloque != nullptr) cola.liberar(bloque);
+
+    if (red.obtener_config().mostrar_progreso) {
+        uint64_t generados = cola.obtener_glifos_generados();
+        double segundos_generacion = cola.obtener_segundos_generacion();
+        cout << "Aumento: " << consumidos_ahora << " variantes consumidas en " << fixed << setprecision(3)
+             << resultado.segundos << " s (" << setprecision(0)
+             << (resultado.segundos > 0 ? consumidos_ahora / resultado.segundos : 0.0) << " glifos/s); generadas "
+             << generados << " a " << (segundos_generacion > 0 ? generados / segundos_generacion : 0.0)
+             << " glifos/s; espera del entrenamiento " << setprecision(1)
+             << cola.obtener_segundos_espera() * 1000.0 << " ms\n";
+    }
+    return resultado;
+}
+
+double precision_con_aumento(RedNeuronal& red, const vector<vector<double>>& glifos,
+                             const vector<int>& etiquetas, const ConfigAumento& config, size_t cantidad) {
+    // Sin originales el generador no produce variantes y el bucle no avanzaría
+    if (glifos.empty() || cantidad == 0) return 0.0;
+    GeneradorAumento generador(glifos, etiquetas, config);
+    BloqueAumento bloque;
+    size_t correctos = 0;
+    for (size_t hechos = 0; hechos < cantidad; hechos += bloque.cantidad) {
+        generador.llenar(bloque, min(GLIFOS_POR_BLOQUE_AUMENTO, cantidad - hechos));
+        if (bloque.cantidad == 0) break;
+        for (size_t i = 0; i < bloque.cantidad; ++i) {
+            if (interpretar_salida(red.forward_bits(bloque.glifos[i]), 0.5) == obtener_clases(bloque.etiquetas[i] % 10)) {
+                correctos++;
+            }
+        }
+    }
+    return 100.0 * correctos / cantidad;
+}
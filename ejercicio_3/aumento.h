@@ -0,0 +1,265 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - AUMENTO DE DATOS EN LÍNEA
+// ============================================================================
+// Variantes de los glifos generadas durante el entrenamiento: píxeles
+// invertidos, desplazamientos de un píxel y trazo engrosado. Cada glifo de
+// 7x5 cabe en una palabra de 64 bits, así que cada transformación son unas
+// pocas operaciones de bits sobre el glifo completo, y la variante se
+// entrena empaquetada por la ruta binaria de la red (EntradaBits). Un hilo
+// productor llena bloques en una cola acotada mientras la red entrena con
+// los anteriores.
+// ============================================================================
+
+#ifndef AUMENTO_H
+#define AUMENTO_H
+
+#include "datos.h"
+
+using namespace std;
+
+// ==================== GLIFO EMPAQUETADO ====================
+// Bit p = píxel p = fila * COLS_DIGITO + columna: el mismo orden que
+// empaquetar_entrada, así que la palabra es directamente una EntradaBits
+static_assert(FILAS_DIGITO * COLS_DIGITO <= 64, "El glifo debe caber en una palabra de 64 bits");
+
+const int PIXELES_GLIFO = FILAS_DIGITO * COLS_DIGITO;
+const uint64_t MASCARA_GLIFO = (uint64_t(1) << PIXELES_GLIFO) - 1;
+
+// Bits de una columna en todas las filas
+constexpr uint64_t mascara_columna(int columna) {
+    uint64_t mascara = 0;
+    for (int f = 0; f < FILAS_DIGITO; ++f) mascara |= uint64_t(1) << (f * COLS_DIGITO + columna);
+    return mascara;
+}
+
+const uint64_t COLUMNA_IZQUIERDA = mascara_columna(0);
+const uint64_t COLUMNA_DERECHA = mascara_columna(COLS_DIGITO - 1);
+
+// Desplazamientos de un píxel; lo que sale del glifo se pierde
+inline uint64_t mover_derecha(uint64_t g) { return (g & ~COLUMNA_DERECHA) << 1; }
+inline uint64_t mover_izquierda(uint64_t g) { return (g & ~COLUMNA_IZQUIERDA) >> 1; }
+inline uint64_t mover_abajo(uint64_t g) { return (g << COLS_DIGITO) & MASCARA_GLIFO; }
+inline uint64_t mover_arriba(uint64_t g) { return g >> COLS_DIGITO; }
+
+uint64_t empaquetar_glifo(const vector<double>& glifo);
+
+// Bloque de variantes empaquetadas (una palabra por glifo)
+struct BloqueAumento {
+    vector<EntradaBits> glifos;
+    vector<int> etiquetas;
+    size_t cantidad = 0;
+};
+
+// ==================== GENERADOR DE VARIANTES ====================
+struct ConfigAumento {
+    int variantes = 8;                  // Variantes por glifo original en cada época
+    double prob_inversion = 0.03;       // Por píxel
+    double prob_desplazamiento = 0.5;   // Un píxel en una dirección al azar
+    double prob_engrosamiento = 0.25;   // Trazo de dos píxeles, horizontal o vertical
+    unsigned semilla = 7;
+};
+
+// Variantes >= 1 y probabilidades en [0, 1]; informa el primer valor que no
+bool validar_config_aumento(const ConfigAumento& config);
+
+// Recorre los originales en orden circular y produce una variante de cada
+// uno. La secuencia depende solo de la semilla.
+class GeneradorAumento {
+private:
+    vector<uint64_t> originales;
+    vector<int> etiquetas;
+    ConfigAumento config;
+    mt19937_64 generador;
+    double log_complemento;   // log(1 - prob_inversion), para los saltos geométricos
+    size_t siguiente;
+
+    // Máscara de píxeles a invertir. En lugar de un sorteo por píxel se
+    // sortea la distancia hasta el próximo invertido (distribución
+    // geométrica): con probabilidad baja basta un sorteo por glifo.
+    uint64_t mascara_inversion() {
+        if (config.prob_inversion <= 0.0) return 0;
+        if (config.prob_inversion >= 1.0) return MASCARA_GLIFO;
+        uint64_t mascara = 0;
+        for (double p = salto(); p < PIXELES_GLIFO; p += 1.0 + salto()) {
+            mascara |= uint64_t(1) << static_cast<int>(p);
+        }
+        return mascara;
+    }
+
+    double salto() {
+        double u = ((generador() >> 11) + 1) * (1.0 / 9007199254740992.0);   // (0, 1]
+        return floor(log(u) / log_complemento);
+    }
+
+public:
+    GeneradorAumento(const vector<vector<double>>& glifos, const vector<int>& etiquetas_glifos,
+                     const ConfigAumento& configuracion)
+        : etiquetas(etiquetas_glifos), config(configuracion), generador(configuracion.semilla),
+          log_complemento(log1p(-configuracion.prob_inversion)), siguiente(0) {
+        for (const vector<double>& g : glifos) originales.push_back(empaquetar_glifo(g));
+    }
+
+    // Variante del glifo: un solo número aleatorio decide desplazamiento y
+    // engrosamiento (16 bits por probabilidad, 2 para la dirección)
+    uint64_t variar(uint64_t g) {
+        uint64_t r = generador();
+        if ((r & 0xFFFF) < config.prob_desplazamiento * 65536.0) {
+            switch ((r >> 16) & 3) {
+                case 0: g = mover_derecha(g); break;
+                case 1: g = mover_izquierda(g); break;
+                case 2: g = mover_abajo(g); break;
+                default: g = mover_arriba(g); break;
+            }
+        }
+        if (((r >> 18) & 0xFFFF) < config.prob_engrosamiento * 65536.0) {
+            g |= ((r >> 34) & 1) ? mover_derecha(g) : mover_abajo(g);
+        }
+        return g ^ mascara_inversion();
+    }
+
+    // Llena el bloque con 'cantidad' variantes consecutivas del flujo
+    void llenar(BloqueAumento& bloque, size_t cantidad) {
+        if (originales.empty()) cantidad = 0;
+        if (bloque.glifos.size() < cantidad) {
+            bloque.glifos.resize(cantidad, EntradaBits(1));
+            bloque.etiquetas.resize(cantidad);
+        }
+        for (size_t i = 0; i < cantidad; ++i) {
+            bloque.glifos[i][0] = variar(originales[siguiente]);
+            bloque.etiquetas[i] = etiquetas[siguiente];
+            if (++siguiente == originales.size()) siguiente = 0;
+        }
+        bloque.cantidad = cantidad;
+    }
+    
+    // Avanza el flujo 'cantidad' variantes sin guardarlas (reanudación): se
+    // hacen los mismos sorteos que al generarlas
+    void saltar(uint64_t cantidad) {
+        if (originales.empty()) return;
+        for (uint64_t i = 0; i < cantidad; ++i) {
+            variar(originales[siguiente]);
+            if (++siguiente == originales.size()) siguiente = 0;
+        }
+    }
+
+    size_t num_originales() const { return originales.size(); }
+};
+
+// ==================== COLA ACOTADA CON PRODUCTOR ====================
+// Igual que ColaPrefetch, pero el flujo no termina: el productor genera
+// variantes hasta que la cola se destruye. Con BLOQUES_COLA_AUMENTO
+// bloques, el productor se detiene cuando va tantos bloques por delante.
+const size_t GLIFOS_POR_BLOQUE_AUMENTO = 1024;
+const int BLOQUES_COLA_AUMENTO = 4;
+
+class ColaAumento {
+private:
+    GeneradorAumento generador;
+    BloqueAumento bloques[BLOQUES_COLA_AUMENTO];
+    queue<BloqueAumento*> llenos;
+    queue<BloqueAumento*> libres;
+    mutex candado;
+    condition_variable aviso;
+    bool cancelado;
+    uint64_t glifos_generados;
+    double segundos_generacion;
+    double segundos_espera;   // Tiempo que el consumidor esperó un bloque
+    thread productor;
+
+    void producir() {
+        while (true) {
+            BloqueAumento* bloque;
+            {
+                unique_lock<mutex> lock(candado);
+                aviso.wait(lock, [this] { return !libres.empty() || cancelado; });
+                if (cancelado) break;
+                bloque = libres.front();
+                libres.pop();
+            }
+
+            auto inicio = chrono::high_resolution_clock::now();
+            generador.llenar(*bloque, GLIFOS_POR_BLOQUE_AUMENTO);
+            auto fin = chrono::high_resolution_clock::now();
+
+            lock_guard<mutex> lock(candado);
+            segundos_generacion += chrono::duration<double>(fin - inicio).count();
+            glifos_generados += bloque->cantidad;
+            llenos.push(bloque);
+            aviso.notify_all();
+        }
+    }
+
+public:
+    // 'saltar' descarta ese número de variantes del principio del flujo
+    ColaAumento(const vector<vector<double>>& glifos, const vector<int>& etiquetas, const ConfigAumento& config,
+                uint64_t saltar = 0)
+        : generador(glifos, etiquetas, config), cancelado(false), glifos_generados(0),
+          segundos_generacion(0.0), segundos_espera(0.0) {
+        generador.saltar(saltar);
+        for (BloqueAumento& b : bloques) libres.push(&b);
+        productor = thread(&ColaAumento::producir, this);
+    }
+
+    ~ColaAumento() {
+        {
+            lock_guard<mutex> lock(candado);
+            cancelado = true;
+        }
+        aviso.notify_all();
+        if (productor.joinable()) productor.join();
+    }
+
+    ColaAumento(const ColaAumento&) = delete;
+    ColaAumento& operator=(const ColaAumento&) = delete;
+
+    // Siguiente bloque lleno (siempre hay uno: el flujo no termina)
+    BloqueAumento* obtener() {
+        auto inicio = chrono::high_resolution_clock::now();
+        unique_lock<mutex> lock(candado);
+        aviso.wait(lock, [this] { return !llenos.empty(); });
+        BloqueAumento* bloque = llenos.front();
+        llenos.pop();
+        segundos_espera += chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+        return bloque;
+    }
+
+    void liberar(BloqueAumento* bloque) {
+        lock_guard<mutex> lock(candado);
+        libres.push(bloque);
+        aviso.notify_all();
+    }
+
+    uint64_t obtener_glifos_generados() {
+        lock_guard<mutex> lock(candado);
+        return glifos_generados;
+    }
+
+    double obtener_segundos_generacion() {
+        lock_guard<mutex> lock(candado);
+        return segundos_generacion;
+    }
+
+    double obtener_segundos_espera() {
+        lock_guard<mutex> lock(candado);
+        return segundos_espera;
+    }
+};
+
+// ==================== ENTRENAMIENTO CON AUMENTO ====================
+// Cada época consume variantes * glifos.size() variantes de la cola. El
+// flujo de variantes es el mismo en cada ejecución con la misma semilla,
+// así que el entrenamiento es reproducible. El checkpoint guarda la
+// semilla y las variantes consumidas: al reanudar, el flujo se regenera
+// con la semilla guardada y se salta lo ya consumido, y el modelo final es
+// el mismo que sin interrupción.
+ResultadoEntrenamiento entrenar_con_aumento(RedNeuronal& red, const vector<vector<double>>& glifos,
+                                            const vector<int>& etiquetas, const ConfigAumento& config,
+                                            const string& archivo_checkpoint = "");
+
+// Porcentaje de 'cantidad' variantes generadas con 'config' cuyo conjunto
+// de clases predicho coincide con el esperado. Con una semilla distinta de
+// la del entrenamiento mide la robustez ante entradas que la red no vio.
+double precision_con_aumento(RedNeuronal& red, const vector<vector<double>>& glifos,
+                             const vector<int>& etiquetas, const ConfigAumento& config, size_t cantidad);
+
+#endif
@@ -0,0 +1,233 @@
+#include "datos.h"
+
+#include <cerrno>
+#include <fstream>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ==================== FUNCIONES DE CLASIFICACIÓN ====================
+vector<int> obtener_clases(int numero) {
+    vector<int> clases;
+    
+    // Clase 0: Pares
+    if (numero % 2 == 0) clases.push_back(0);
+    
+    // Clase 1: Impares
+    if (numero % 2 == 1) clases.push_back(1);
+    
+    // Clase 2: Primos (2, 3, 5, 7)
+    if (numero == 2 || numero == 3 || numero == 5 || numero == 7) {
+        clases.push_back(2);
+    }
+    
+    // Clase 3: Compuestos (4, 6, 8, 9)
+    if (numero == 4 || numero == 6 || numero == 8 || numero == 9) {
+        clases.push_back(3);
+    }
+    
+    return clases;
+}
+
+vector<double> clases_a_vector(const vector<int>& clases) {
+    vector<double> objetivo(SALIDAS, 0.0);
+    for (int clase : clases) {
+        objetivo[clase] = 1.0;  // Activar las clases correspondientes
+    }
+    return objetivo;
+}
+
+vector<int> interpretar_salida(const vector<double>& salida, double umbral) {
+    vector<int> clases_predichas;
+    for (int i = 0; i < SALIDAS; ++i) {
+        if (salida[i] > umbral) {
+            clases_predichas.push_back(i);
+        }
+    }
+    return clases_predichas;
+}
+
+// ==================== CARGA DE DATOS ====================
+size_t leer_origen(FILE* archivo, int descriptor, char* destino, size_t n, bool* error) {
+    if (archivo != nullptr) {
+        size_t leidos = fread(destino, 1, n, archivo);
+        if (error != nullptr) *error = leidos < n && ferror(archivo) != 0;
+        return leidos;
+    }
+#ifdef _WIN32
+    (void)descriptor; (void)destino; (void)n;
+    if (error != nullptr) *error = true;
+    return 0;
+#else
+    ssize_t leidos;
+    do {
+        leidos = ::read(descriptor, destino, n);
+    } while (leidos < 0 && errno == EINTR);
+    if (error != nullptr) *error = leidos < 0;
+    return leidos > 0 ? static_cast<size_t>(leidos) : 0;
+#endif
+}
+
+void cerrar_descriptor(int descriptor) {
+#ifndef _WIN32
+    ::close(descriptor);
+#else
+    (void)descriptor;
+#endif
+}
+
+namespace {
+
+// Detecta el formato por los primeros bytes. En un socket la cabecera puede
+// llegar en varias lecturas: se sigue leyendo solo mientras lo recibido
+// pueda ser aún el comienzo de la magia binaria (un texto se reconoce en
+// el primer byte y no se espera a más datos).
+unique_ptr<LectorGlifos> crear_lector(FILE* archivo, int descriptor, const string& nombre,
+                                      int filas, int columnas) {
+    size_t pixeles = static_cast<size_t>(filas) * columnas;
+    
+    CabeceraGlifos cabecera;
+    char* bytes = reinterpret_cast<char*>(&cabecera);
+    size_t n = 0;
+    while (n < sizeof(cabecera)) {
+        size_t leidos = leer_origen(archivo, descriptor, bytes + n, sizeof(cabecera) - n);
+        if (leidos == 0) break;
+        n += leidos;
+        if (!equal(bytes, bytes + min(n, sizeof(MAGIA_GLIFOS)), begin(MAGIA_GLIFOS))) break;
+    }
+    
+    if (n == sizeof(cabecera) && equal(begin(MAGIA_GLIFOS), end(MAGIA_GLIFOS), cabecera.magia)) {
+        if (cabecera.filas != static_cast<uint32_t>(filas) || cabecera.columnas != static_cast<uint32_t>(columnas)) {
+            cerr << "Error: " << nombre << " contiene glifos de " << cabecera.filas << "x"
+                 << cabecera.columnas << ", se esperaban " << filas << "x" << columnas << endl;
+            if (archivo != nullptr) fclose(archivo);
+            else cerrar_descriptor(descriptor);
+            return nullptr;
+        }
+        return unique_ptr<LectorGlifos>(new LectorBinario(archivo, descriptor, pixeles, cabecera.cantidad));
+    }
+    
+    return unique_ptr<LectorGlifos>(new LectorTexto(archivo, descriptor, pixeles, bytes, n));
+}
+
+} // namespace
+
+unique_ptr<LectorGlifos> crear_lector_glifos(FILE* archivo, const string& nombre,
+                                             int filas, int columnas) {
+    return crear_lector(archivo, -1, nombre, filas, columnas);
+}
+
+unique_ptr<LectorGlifos> crear_lector_glifos_descriptor(int descriptor, const string& nombre,
+                                                        int filas, int columnas) {
+    return crear_lector(nullptr, descriptor, nombre, filas, columnas);
+}
+
+unique_ptr<LectorGlifos> abrir_lector_glifos(const string& nombre_archivo,
+                                             int filas, int columnas) {
+    FILE* archivo = fopen(nombre_archivo.c_str(), "rb");
+    if (archivo == nullptr) {
+        cerr << "Error: No se pudo abrir el archivo " << nombre_archivo << endl;
+        return nullptr;
+    }
+    return crear_lector_glifos(archivo, nombre_archivo, filas, columnas);
+}
+
+bool convertir_a_binario(const string& origen, const string& destino,
+                         int filas, int columnas) {
+    unique_ptr<LectorGlifos> lector = abrir_lector_glifos(origen, filas, columnas);
+    if (!lector) return false;
+    
+    ofstream salida(destino, ios::binary | ios::trunc);
+    if (!salida.is_open()) {
+        cerr << "Error: No se pudo crear el archivo " << destino << endl;
+        return false;
+    }
+    
+    CabeceraGlifos cabecera = {};
+    copy(begin(MAGIA_GLIFOS), end(MAGIA_GLIFOS), cabecera.magia);
+    cabecera.filas = static_cast<uint32_t>(filas);
+    cabecera.columnas = static_cast<uint32_t>(columnas);
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));   // Cantidad provisional
+    
+    size_t pixeles = static_cast<size_t>(filas) * columnas;
+    vector<char> registro(1 + (pixeles + 7) / 8);
+    BloqueDatos bloque;
+    while (lector->leer_bloque(bloque, GLIFOS_POR_BLOQUE)) {
+        for (size_t g = 0; g < bloque.cantidad; ++g) {
+            fill(registro.begin(), registro.end(), 0);
+            registro[0] = static_cast<char>(bloque.etiquetas[g]);
+            for (size_t p = 0; p < pixeles; ++p) {
+                if (bloque.glifos[g][p] > 0.5) registro[1 + p / 8] |= static_cast<char>(1u << (p % 8));
+            }
+            salida.write(registro.data(), static_cast<streamsize>(registro.size()));
+        }
+    }
+    
+    cabecera.cantidad = lector->obtener_glifos_leidos();
+    salida.seekp(0);
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    return static_cast<bool>(salida);
+}
+
+void reportar_lectura(const string& nombre_archivo, uint64_t bytes, double segundos) {
+    double megabytes = bytes / (1024.0 * 1024.0);
+    cout << "Leídos " << bytes << " bytes de " << nombre_archivo << " ("
+         << fixed << setprecision(1) << (segundos > 0 ? megabytes / segundos : 0.0) << " MB/s)\n";
+}
+
+vector<vector<double>> cargar_digitos(const string& nombre_archivo,
+                                      size_t maximo, bool silencioso) {
+    unique_ptr<LectorGlifos> lector = abrir_lector_glifos(nombre_archivo);
+    if (!lector) return {};
+    
+    vector<vector<double>> digitos;
+    BloqueDatos bloque;
+    auto inicio = chrono::high_resolution_clock::now();
+    while (digitos.size() < maximo
+           && lector->leer_bloque(bloque, min(GLIFOS_POR_BLOQUE, maximo - digitos.size()))) {
+        for (size_t g = 0; g < bloque.cantidad; ++g) {
+            digitos.push_back(bloque.glifos[g]);
+        }
+    }
+    auto fin = chrono::high_resolution_clock::now();
+    
+    if (!silencioso) {
+        cout << "Cargados " << digitos.size() << " dígitos desde " << nombre_archivo << endl;
+        reportar_lectura(nombre_archivo, lector->obtener_bytes_leidos(),
+                         chrono::duration<double>(fin - inicio).count());
+    }
+    return digitos;
+}
+
+bool entrenar_desde_archivo(RedNeuronal& red, const string& nombre_archivo,
+                            const string& archivo_checkpoint, bool silencioso) {
+    vector<vector<double>> objetivo_por_etiqueta;
+    for (int numero = 0; numero < 10; ++numero) {
+        objetivo_por_etiqueta.push_back(clases_a_vector(obtener_clases(numero)));
+    }
+    
+    uint64_t bytes_totales = 0;
+    double segundos_lectura = 0.0;
+    ResultadoEntrenamiento resultado = red.entrenar_recorrido([&](auto&& entrenar_patron) {
+        ColaPrefetch cola(abrir_lector_glifos(nombre_archivo));
+        while (BloqueDatos* bloque = cola.obtener()) {
+            for (size_t g = 0; g < bloque->cantidad; ++g) {
+                entrenar_patron(bloque->glifos[g], objetivo_por_etiqueta[bloque->etiquetas[g] % 10]);
+            }
+            cola.liberar(bloque);
+        }
+        bytes_totales += cola.obtener_bytes_leidos();
+        segundos_lectura += cola.obtener_segundos_lectura();
+        return !cola.hubo_error();
+    }, archivo_checkpoint);
+    
+    if (resultado.interrumpido) {
+        cerr << "Error: Falló la lectura de " << nombre_archivo << " en la época " << red.obtener_epoca() + 1
+             << "; el modelo no se guarda como entrenado\n";
+        return false;
+    }
+    if (!silencioso) reportar_lectura(nombre_archivo, bytes_totales, segundos_lectura);
+    return true;
+}
@@ -0,0 +1,355 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - DATOS
+// ============================================================================
+// Clases de cada dígito y lectura de glifos en texto o binario compacto,
+// en bloques y con un hilo de prefetch.
+// ============================================================================
+
+#ifndef DATOS_H
+#define DATOS_H
+
+#include <cstdio>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "red_neuronal.h"
+
+using namespace std;
+
+// ==================== FUNCIONES DE CLASIFICACIÓN ====================
+// Determina las clases a las que pertenece un número
+vector<int> obtener_clases(int numero);
+
+// Convierte las clases en un vector objetivo (one-hot encoding modificado)
+vector<double> clases_a_vector(const vector<int>& clases);
+
+// Interpreta la salida de la red
+vector<int> interpretar_salida(const vector<double>& salida, double umbral = 0.5);
+
+// ==================== CARGA DE DATOS ====================
+// Dos formatos de entrada, detectados por los primeros bytes del archivo:
+//  - Texto (digitos.txt): enteros 0/1 separados por espacios, un glifo
+//    cada FILAS x COLS valores. La etiqueta es la posición módulo 10
+//    (el archivo original lista los dígitos 0..9 en orden).
+//  - Binario compacto (.glb): cabecera CabeceraGlifos y registros de
+//    1 byte de etiqueta + píxeles empaquetados (bit i del byte i/8).
+const char MAGIA_GLIFOS[8] = {'G', 'L', 'I', 'F', 'O', 'S', '1', '\0'};
+const size_t TAMANO_BUFFER_LECTURA = 1 << 20;   // 1 MiB por lectura
+const size_t GLIFOS_POR_BLOQUE = 4096;
+
+struct CabeceraGlifos {
+    char magia[8];
+    uint32_t filas;
+    uint32_t columnas;
+    uint64_t cantidad;
+};
+
+// Bloque de glifos leídos; su memoria se reutiliza entre lecturas
+struct BloqueDatos {
+    vector<vector<double>> glifos;
+    vector<int> etiquetas;
+    size_t cantidad = 0;   // Glifos válidos en el bloque
+};
+
+// Lee hasta 'n' bytes de un FILE* (fread: espera a completarlos o al
+// final) o, si archivo es nullptr, del descriptor con read(): devuelve lo
+// que haya llegado, sin esperar a llenar el destino. 0 al final del flujo.
+// Con 'error', indica además si la lectura falló en lugar de terminar.
+size_t leer_origen(FILE* archivo, int descriptor, char* destino, size_t n, bool* error = nullptr);
+void cerrar_descriptor(int descriptor);
+
+class LectorGlifos {
+protected:
+    FILE* archivo;
+    int descriptor;              // Socket o tubería (si archivo es nullptr)
+    vector<char> buffer;
+    size_t pixeles_por_glifo;
+    uint64_t glifos_leidos;
+    uint64_t bytes_leidos;
+    bool error_lectura;          // Fallo de E/S o binario truncado
+    
+    // Rellena el buffer a partir de 'desde'; devuelve los bytes nuevos
+    // (0 al final o si la lectura falla)
+    size_t rellenar(size_t desde = 0) {
+        bool fallo = false;
+        size_t n = leer_origen(archivo, descriptor, buffer.data() + desde, buffer.size() - desde, &fallo);
+        bytes_leidos += n;
+        error_lectura |= fallo;
+        return n;
+    }
+
+public:
+    LectorGlifos(FILE* f, int fd, size_t pixeles)
+        : archivo(f), descriptor(fd), buffer(TAMANO_BUFFER_LECTURA), pixeles_por_glifo(pixeles),
+          glifos_leidos(0), bytes_leidos(0), error_lectura(false) {}
+    virtual ~LectorGlifos() {
+        if (archivo != nullptr) fclose(archivo);
+        else if (descriptor >= 0) cerrar_descriptor(descriptor);
+    }
+    
+    LectorGlifos(const LectorGlifos&) = delete;
+    LectorGlifos& operator=(const LectorGlifos&) = delete;
+    
+    // Llena el bloque con hasta 'maximo' glifos; false si no quedan datos
+    virtual bool leer_bloque(BloqueDatos& bloque, size_t maximo) = 0;
+    
+    uint64_t obtener_bytes_leidos() const { return bytes_leidos; }
+    uint64_t obtener_glifos_leidos() const { return glifos_leidos; }
+    // La lectura terminó por un error y no por el final de los datos
+    bool hubo_error() const { return error_lectura; }
+
+protected:
+    // Prepara el almacenamiento del bloque sin liberar la memoria previa
+    void preparar(BloqueDatos& bloque, size_t maximo) const {
+        if (bloque.glifos.size() < maximo) {
+            bloque.glifos.resize(maximo, vector<double>(pixeles_por_glifo));
+            bloque.etiquetas.resize(maximo);
+        }
+        bloque.cantidad = 0;
+    }
+};
+
+// Tokenizador a mano sobre el buffer: evita el coste de operator>> por valor
+class LectorTexto : public LectorGlifos {
+private:
+    size_t posicion;
+    size_t fin;
+    
+    // Siguiente entero no negativo del archivo; false al llegar al final
+    bool siguiente_entero(int& valor) {
+        bool en_numero = false;
+        valor = 0;
+        while (true) {
+            if (posicion == fin) {
+                fin = rellenar();
+                posicion = 0;
+                if (fin == 0) return en_numero;
+            }
+            char c = buffer[posicion];
+            if (c >= '0' && c <= '9') {
+                valor = valor * 10 + (c - '0');
+                en_numero = true;
+            } else if (en_numero) {
+                return true;   // El separador se consume con el número
+            }
+            ++posicion;
+        }
+    }
+
+public:
+    // 'prefijo' son bytes ya leídos del flujo (al detectar el formato) que
+    // deben parsearse antes que el resto; así no hace falta retroceder, lo
+    // que no es posible en un socket o una tubería
+    LectorTexto(FILE* f, int fd, size_t pixeles, const char* prefijo = nullptr, size_t bytes_prefijo = 0)
+        : LectorGlifos(f, fd, pixeles), posicion(0), fin(bytes_prefijo) {
+        copy(prefijo, prefijo + bytes_prefijo, buffer.begin());
+        bytes_leidos = bytes_prefijo;
+    }
+    
+    bool leer_bloque(BloqueDatos& bloque, size_t maximo) override {
+        preparar(bloque, maximo);
+        int valor;
+        while (bloque.cantidad < maximo) {
+            vector<double>& glifo = bloque.glifos[bloque.cantidad];
+            size_t p = 0;
+            while (p < pixeles_por_glifo && siguiente_entero(valor)) {
+                glifo[p++] = static_cast<double>(valor);
+            }
+            if (p < pixeles_por_glifo) break;   // Glifo incompleto al final: se descarta
+            
+            bloque.etiquetas[bloque.cantidad] = static_cast<int>(glifos_leidos % 10);
+            bloque.cantidad++;
+            glifos_leidos++;
+        }
+        return bloque.cantidad > 0;
+    }
+};
+
+class LectorBinario : public LectorGlifos {
+private:
+    uint64_t restantes;
+    size_t bytes_registro;   // 1 (etiqueta) + píxeles empaquetados
+    size_t posicion;
+    size_t fin;
+
+public:
+    LectorBinario(FILE* f, int fd, size_t pixeles, uint64_t cantidad)
+        : LectorGlifos(f, fd, pixeles), restantes(cantidad),
+          bytes_registro(1 + (pixeles + 7) / 8), posicion(0), fin(0) {
+        // Un número entero de registros por lectura simplifica el recorrido
+        buffer.resize(TAMANO_BUFFER_LECTURA / bytes_registro * bytes_registro);
+    }
+    
+    bool leer_bloque(BloqueDatos& bloque, size_t maximo) override {
+        preparar(bloque, maximo);
+        while (bloque.cantidad < maximo && restantes > 0) {
+            if (fin - posicion < bytes_registro) {
+                // Registro incompleto (un socket entrega lo que haya llegado):
+                // se mueve al inicio del buffer y se completa
+                size_t pendiente = fin - posicion;
+                copy(buffer.begin() + static_cast<ptrdiff_t>(posicion),
+                     buffer.begin() + static_cast<ptrdiff_t>(fin), buffer.begin());
+                size_t n = rellenar(pendiente);
+                posicion = 0;
+                fin = pendiente + n;
+                if (n == 0) {
+                    // Fin de archivo antes de la cantidad de la cabecera
+                    // (salvo UINT64_MAX, "hasta el final del flujo")
+                    if (restantes != numeric_limits<uint64_t>::max()) error_lectura = true;
+                    break;
+                }
+                continue;
+            }
+            const unsigned char* registro = reinterpret_cast<const unsigned char*>(&buffer[posicion]);
+            vector<double>& glifo = bloque.glifos[bloque.cantidad];
+            for (size_t p = 0; p < pixeles_por_glifo; ++p) {
+                glifo[p] = static_cast<double>((registro[1 + p / 8] >> (p % 8)) & 1u);
+            }
+            bloque.etiquetas[bloque.cantidad] = registro[0];
+            bloque.cantidad++;
+            glifos_leidos++;
+            restantes--;
+            posicion += bytes_registro;
+        }
+        return bloque.cantidad > 0;
+    }
+};
+
+// Crea el lector adecuado para un flujo ya abierto detectando su formato.
+// Toma posesión de 'archivo'. Devuelve nullptr si las dimensiones del
+// binario no coinciden. En el binario, cantidad = UINT64_MAX significa
+// "hasta el final del flujo".
+unique_ptr<LectorGlifos> crear_lector_glifos(FILE* archivo, const string& nombre,
+                                             int filas = FILAS_DIGITO, int columnas = COLS_DIGITO);
+
+// Igual, sobre un socket o tubería (POSIX). Se lee con read(): cada glifo se
+// entrega en cuanto llegan sus bytes, sin esperar a llenar el buffer ni a
+// que el otro extremo cierre. Toma posesión del descriptor.
+unique_ptr<LectorGlifos> crear_lector_glifos_descriptor(int descriptor, const string& nombre,
+                                                        int filas = FILAS_DIGITO, int columnas = COLS_DIGITO);
+
+// Abre un archivo de glifos detectando su formato. Devuelve nullptr si no
+// se puede abrir o si las dimensiones del binario no coinciden.
+unique_ptr<LectorGlifos> abrir_lector_glifos(const string& nombre_archivo,
+                                             int filas = FILAS_DIGITO, int columnas = COLS_DIGITO);
+
+// Convierte un archivo de glifos (texto o binario) al formato binario compacto
+bool convertir_a_binario(const string& origen, const string& destino,
+                         int filas = FILAS_DIGITO, int columnas = COLS_DIGITO);
+
+// ==================== LECTURA CON PREFETCH ====================
+// Un hilo productor llena bloques mientras el consumidor entrena con el
+// anterior (doble buffer): la E/S y el parseo se solapan con el cómputo.
+class ColaPrefetch {
+private:
+    unique_ptr<LectorGlifos> lector;
+    BloqueDatos bloques[2];
+    queue<BloqueDatos*> llenos;
+    queue<BloqueDatos*> libres;
+    mutex candado;
+    condition_variable aviso;
+    bool fin_datos;
+    bool cancelado;
+    double segundos_lectura;
+    thread productor;
+    
+    void producir() {
+        while (true) {
+            BloqueDatos* bloque;
+            {
+                unique_lock<mutex> lock(candado);
+                aviso.wait(lock, [this] { return !libres.empty() || cancelado; });
+                if (cancelado) break;
+                bloque = libres.front();
+                libres.pop();
+            }
+            
+            auto inicio = chrono::high_resolution_clock::now();
+            bool hay_datos = lector->leer_bloque(*bloque, GLIFOS_POR_BLOQUE);
+            auto fin = chrono::high_resolution_clock::now();
+            
+            lock_guard<mutex> lock(candado);
+            segundos_lectura += chrono::duration<double>(fin - inicio).count();
+            if (!hay_datos) {
+                fin_datos = true;
+                aviso.notify_all();
+                break;
+            }
+            llenos.push(bloque);
+            aviso.notify_all();
+        }
+    }
+
+public:
+    explicit ColaPrefetch(unique_ptr<LectorGlifos> lector_glifos)
+        : lector(move(lector_glifos)), fin_datos(false), cancelado(false), segundos_lectura(0.0) {
+        libres.push(&bloques[0]);
+        libres.push(&bloques[1]);
+        if (lector) {
+            productor = thread(&ColaPrefetch::producir, this);
+        } else {
+            fin_datos = true;   // Archivo no disponible: la cola queda vacía
+        }
+    }
+    
+    ~ColaPrefetch() {
+        {
+            lock_guard<mutex> lock(candado);
+            cancelado = true;
+        }
+        aviso.notify_all();
+        if (productor.joinable()) productor.join();
+    }
+    
+    // Siguiente bloque lleno; nullptr cuando no quedan datos
+    BloqueDatos* obtener() {
+        unique_lock<mutex> lock(candado);
+        aviso.wait(lock, [this] { return !llenos.empty() || fin_datos; });
+        if (llenos.empty()) return nullptr;
+        BloqueDatos* bloque = llenos.front();
+        llenos.pop();
+        return bloque;
+    }
+    
+    // Devuelve un bloque ya consumido para que el productor lo reutilice
+    void liberar(BloqueDatos* bloque) {
+        lock_guard<mutex> lock(candado);
+        libres.push(bloque);
+        aviso.notify_all();
+    }
+    
+    uint64_t obtener_bytes_leidos() {
+        lock_guard<mutex> lock(candado);
+        return lector ? lector->obtener_bytes_leidos() : 0;
+    }
+    
+    double obtener_segundos_lectura() {
+        lock_guard<mutex> lock(candado);
+        return segundos_lectura;
+    }
+    
+    // El archivo no se pudo abrir o la lectura falló antes del final
+    bool hubo_error() {
+        lock_guard<mutex> lock(candado);
+        return !lector || lector->hubo_error();
+    }
+};
+
+void reportar_lectura(const string& nombre_archivo, uint64_t bytes, double segundos);
+
+// Lee los dígitos desde el archivo (texto o binario). Con 'maximo' se
+// cargan solo los primeros glifos, útil cuando el resto se lee en flujo.
+// Con 'silencioso' no se reportan la cantidad ni la velocidad de lectura.
+vector<vector<double>> cargar_digitos(const string& nombre_archivo,
+                                      size_t maximo = numeric_limits<size_t>::max(),
+                                      bool silencioso = false);
+
+// Entrena leyendo el archivo en flujo en cada época, sin cargarlo completo.
+// Devuelve false si una época no pudo leer el archivo completo: esa época
+// no cuenta, no se guarda el checkpoint y el modelo no queda finalizado.
+bool entrenar_desde_archivo(RedNeuronal& red, const string& nombre_archivo,
+                            const string& archivo_checkpoint = "", bool silencioso = false);
+
+#endif
@@ -11,350 +11,698 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
-#include <cmath>
 #include <string>
 #include <iomanip>
-#include <random>
-#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+#ifdef _WIN32
 #include <windows.h>   // Para activar UTF-8 en Windows
+#endif
+
+#include "red_neuronal.h"
+#include "inferencia.h"
+#include "datos.h"
+#include "servicio.h"
+#include "validacion.h"
+#include "aumento.h"
+#include "argumentos.h"
 
 using namespace std;
 
-// ==================== CONSTANTES ====================
-const int FILAS_DIGITO = 7;      // Altura de cada dígito (7 filas)
-const int COLS_DIGITO = 5;       // Ancho de cada dígito (5 columnas)
-const int ENTRADAS = 35;         // Total de píxeles (7x5 = 35)
-const int NEURONAS_OCULTA = 20;  // Neuronas en la capa oculta
-const int SALIDAS = 4;           // 4 categorías de clasificación
-const double TASA_APRENDIZAJE = 0.1;
-const int EPOCAS = 5000;         // Número de iteraciones de entrenamiento
+// ==================== ARCHIVOS ====================
+// Valores por defecto; --entrada y --modelo los reemplazan
+const string ARCHIVO_DIGITOS = "digitos.txt";         // Glifos de entrada (texto o binario)
+const string ARCHIVO_MODELO = "modelo_digitos.rnc";   // Checkpoint de la red entrenada
+const uint64_t LIMITE_CARGA_COMPLETA = 64ull << 20;   // Mayor que esto: entrenar en flujo
+const size_t VARIANTES_EVALUACION = 1000;             // Variantes no vistas para medir robustez
 
-// ==================== FUNCIÓN DE ACTIVACIÓN SIGMOIDE ====================
-// Squash de valores al rango (0, 1)
-double sigmoide(double x) {
-    return 1.0 / (1.0 + exp(-x));
-}
+// ==================== OPCIONES DE ENTRENAMIENTO ====================
+// Optimizador, calendario y parada temprana; valen para la demostración y
+// para cada entrenamiento de la validación cruzada
+const vector<string> OPCIONES_ENTRENAMIENTO = {
+    "optimizador", "momento", "beta1", "beta2", "calendario", "paso-calendario",
+    "factor-calendario", "error-objetivo", "paciencia", "mejora-minima", "tasa", "epocas"
+};
 
-// Derivada de la sigmoide (para backpropagation)
-double derivada_sigmoide(double x) {
-    return x * (1.0 - x);
+// Aplica sobre 'config' las opciones presentes; las ausentes conservan su
+// valor (el guardado en el checkpoint al reanudar). La tasa y las épocas
+// se leen aparte porque en la validación cruzada son listas.
+bool leer_opciones_entrenamiento(const Argumentos& argumentos, ConfigEntrenamiento& config) {
+    if (argumentos.tiene("optimizador")
+        && !interpretar_optimizador(argumentos.obtener("optimizador"), config.optimizador)) {
+        return false;
+    }
+    if (argumentos.tiene("calendario")
+        && !interpretar_calendario(argumentos.obtener("calendario"), config.calendario)) {
+        return false;
+    }
+    if (!argumentos.obtener_real("momento", config.momento)
+        || !argumentos.obtener_real("beta1", config.beta1)
+        || !argumentos.obtener_real("beta2", config.beta2)
+        || !argumentos.obtener_entero("paso-calendario", config.paso_calendario)
+        || !argumentos.obtener_real("factor-calendario", config.factor_calendario)
+        || !argumentos.obtener_real("error-objetivo", config.error_objetivo)
+        || !argumentos.obtener_entero("paciencia", config.paciencia)
+        || !argumentos.obtener_real("mejora-minima", config.mejora_minima)) {
+        return false;
+    }
+    return validar_config(config);
 }
 
-// ==================== CLASE: RED NEURONAL ====================
-class RedNeuronal {
-private:
-    // Pesos de las conexiones entre capas
-    vector<vector<double>> pesos_entrada_oculta;   // [ENTRADAS][NEURONAS_OCULTA]
-    vector<vector<double>> pesos_oculta_salida;    // [NEURONAS_OCULTA][SALIDAS]
-    
-    // Sesgos (bias) de cada capa
-    vector<double> sesgo_oculta;   // [NEURONAS_OCULTA]
-    vector<double> sesgo_salida;   // [SALIDAS]
-    
-    // Activaciones de cada capa (valores de las neuronas)
-    vector<double> activacion_entrada;   // [ENTRADAS]
-    vector<double> activacion_oculta;    // [NEURONAS_OCULTA]
-    vector<double> activacion_salida;    // [SALIDAS]
-    
-    // Generador de números aleatorios
-    mt19937 generador;
-    
-    // Inicializa pesos con valores aleatorios pequeños
-    void inicializar_pesos() {
-        uniform_real_distribution<double> dist(-0.5, 0.5);
-        
-        // Inicializar pesos entre entrada y capa oculta
-        pesos_entrada_oculta.resize(ENTRADAS, vector<double>(NEURONAS_OCULTA));
-        for (int i = 0; i < ENTRADAS; ++i) {
-            for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-                pesos_entrada_oculta[i][j] = dist(generador);
-            }
-        }
-        
-        // Inicializar pesos entre capa oculta y salida
-        pesos_oculta_salida.resize(NEURONAS_OCULTA, vector<double>(SALIDAS));
-        for (int i = 0; i < NEURONAS_OCULTA; ++i) {
-            for (int j = 0; j < SALIDAS; ++j) {
-                pesos_oculta_salida[i][j] = dist(generador);
-            }
-        }
-        
-        // Inicializar sesgos
-        sesgo_oculta.resize(NEURONAS_OCULTA);
-        sesgo_salida.resize(SALIDAS);
-        for (int i = 0; i < NEURONAS_OCULTA; ++i) {
-            sesgo_oculta[i] = dist(generador);
-        }
-        for (int i = 0; i < SALIDAS; ++i) {
-            sesgo_salida[i] = dist(generador);
+// ==================== VISUALIZACIÓN ====================
+// Muestra un dígito en formato ASCII
+void mostrar_digito(const vector<double>& digito) {
+    for (int i = 0; i < FILAS_DIGITO; ++i) {
+        for (int j = 0; j < COLS_DIGITO; ++j) {
+            int idx = i * COLS_DIGITO + j;
+            cout << (digito[idx] > 0.5 ? "█" : " ") << " ";
         }
+        cout << endl;
     }
+}
 
-public:
-    RedNeuronal() : generador(42) {  // Semilla fija para reproducibilidad
-        activacion_entrada.resize(ENTRADAS);
-        activacion_oculta.resize(NEURONAS_OCULTA);
-        activacion_salida.resize(SALIDAS);
-        inicializar_pesos();
-    }
-    
-    // PROPAGACIÓN HACIA ADELANTE (Forward Propagation)
-    // Calcula la salida de la red dada una entrada
-    vector<double> forward(const vector<double>& entrada) {
-        // Copiar entrada a la capa de entrada
-        activacion_entrada = entrada;
-        
-        // Calcular activaciones de la capa oculta
-        for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-            double suma = sesgo_oculta[j];
-            for (int i = 0; i < ENTRADAS; ++i) {
-                suma += activacion_entrada[i] * pesos_entrada_oculta[i][j];
-            }
-            activacion_oculta[j] = sigmoide(suma);
-        }
-        
-        // Calcular activaciones de la capa de salida
-        for (int k = 0; k < SALIDAS; ++k) {
-            double suma = sesgo_salida[k];
-            for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-                suma += activacion_oculta[j] * pesos_oculta_salida[j][k];
-            }
-            activacion_salida[k] = sigmoide(suma);
-        }
-        
-        return activacion_salida;
+// Convierte clases en nombres descriptivos
+string nombre_clase(int clase) {
+    switch(clase) {
+        case 0: return "Par";
+        case 1: return "Impar";
+        case 2: return "Primo";
+        case 3: return "Compuesto";
+        default: return "Desconocido";
     }
-    
-    // RETROPROPAGACIÓN (Backpropagation)
-    // Ajusta los pesos de la red para minimizar el error
-    void backward(const vector<double>& objetivo) {
-        // Calcular error en la capa de salida
-        vector<double> error_salida(SALIDAS);
-        for (int k = 0; k < SALIDAS; ++k) {
-            double error = objetivo[k] - activacion_salida[k];
-            error_salida[k] = error * derivada_sigmoide(activacion_salida[k]);
-        }
-        
-        // Calcular error en la capa oculta
-        vector<double> error_oculta(NEURONAS_OCULTA);
-        for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-            double error = 0.0;
-            for (int k = 0; k < SALIDAS; ++k) {
-                error += error_salida[k] * pesos_oculta_salida[j][k];
-            }
-            error_oculta[j] = error * derivada_sigmoide(activacion_oculta[j]);
-        }
-        
-        // Actualizar pesos entre capa oculta y salida
-        for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-            for (int k = 0; k < SALIDAS; ++k) {
-                pesos_oculta_salida[j][k] += TASA_APRENDIZAJE * error_salida[k] * activacion_oculta[j];
-            }
-        }
-        
-        // Actualizar pesos entre entrada y capa oculta
-        for (int i = 0; i < ENTRADAS; ++i) {
-            for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-                pesos_entrada_oculta[i][j] += TASA_APRENDIZAJE * error_oculta[j] * activacion_entrada[i];
-            }
-        }
-        
-        // Actualizar sesgos de la capa de salida
-        for (int k = 0; k < SALIDAS; ++k) {
-            sesgo_salida[k] += TASA_APRENDIZAJE * error_salida[k];
-        }
-        
-        // Actualizar sesgos de la capa oculta
-        for (int j = 0; j < NEURONAS_OCULTA; ++j) {
-            sesgo_oculta[j] += TASA_APRENDIZAJE * error_oculta[j];
-        }
+}
+
+// ==================== COMPARACIÓN DE RUTAS DE INFERENCIA ====================
+// Valida cada ruta contra las clases predichas por la red en double y mide
+// latencia media por dígito y throughput repitiendo la clasificación.
+template <typename FuncionPrediccion>
+void medir_ruta(const string& nombre, int repeticiones, size_t num_digitos,
+                const vector<vector<int>>& referencia, FuncionPrediccion predecir) {
+    int coincidencias = 0;
+    for (size_t d = 0; d < num_digitos; ++d) {
+        if (interpretar_salida(predecir(d), 0.5) == referencia[d]) coincidencias++;
     }
     
-    // Entrena la red con un conjunto de datos
-    void entrenar(const vector<vector<double>>& datos, const vector<vector<double>>& objetivos) {
-        cout << "\nEntrenando la red neuronal...\n";
-        
-        for (int epoca = 0; epoca < EPOCAS; ++epoca) {
-            double error_total = 0.0;
-            
-            // Entrenar con cada patrón
-            for (size_t i = 0; i < datos.size(); ++i) {
-                vector<double> salida = forward(datos[i]);
-                backward(objetivos[i]);
-                
-                // Calcular error cuadrático medio
-                for (int k = 0; k < SALIDAS; ++k) {
-                    double diff = objetivos[i][k] - salida[k];
-                    error_total += diff * diff;
-                }
-            }
-            
-            // Mostrar progreso cada 500 épocas
-            if ((epoca + 1) % 500 == 0) {
-                cout << "Época " << (epoca + 1) << "/" << EPOCAS 
-                     << " - Error: " << fixed << setprecision(6) << error_total << endl;
-            }
+    double control = 0.0;   // Suma de control de las predicciones
+    auto inicio = chrono::high_resolution_clock::now();
+    for (int r = 0; r < repeticiones; ++r) {
+        for (size_t d = 0; d < num_digitos; ++d) {
+            control += predecir(d)[0];
         }
-        
-        cout << "¡Entrenamiento completado!\n\n";
     }
+    auto fin = chrono::high_resolution_clock::now();
+    // Sumidero volatile: su escritura obliga a ejecutar las predicciones
+    volatile double sumidero = control;
+    (void)sumidero;
     
-    // Predice la clase de un patrón de entrada
-    vector<double> predecir(const vector<double>& entrada) {
-        return forward(entrada);
+    double segundos = chrono::duration<double>(fin - inicio).count();
+    double total = static_cast<double>(repeticiones) * num_digitos;
+    double latencia_ns = segundos * 1e9 / total;
+    double throughput = total / segundos;
+    
+    cout << left << setw(22) << nombre << right
+         << setw(6) << coincidencias << "/" << left << setw(5) << num_digitos << right
+         << setw(12) << fixed << setprecision(1) << latencia_ns
+         << setw(16) << setprecision(0) << throughput << endl;
+}
+
+void comparar_rutas_inferencia(RedNeuronal& red, const vector<vector<double>>& digitos,
+                               int repeticiones = 20000) {
+    RedNeuronalF32 red_f32(red);
+    RedNeuronalInt8 red_int8(red);
+    
+    vector<vector<float>> digitos_f32;
+    vector<EntradaBits> digitos_bits;
+    vector<vector<int>> referencia;
+    for (const auto& d : digitos) {
+        digitos_f32.emplace_back(d.begin(), d.end());
+        digitos_bits.push_back(empaquetar_entrada(d));
+        referencia.push_back(interpretar_salida(red.predecir(d), 0.5));
     }
-};
+    
+    cout << "============================================\n";
+    cout << "     COMPARACIÓN DE RUTAS DE INFERENCIA\n";
+    cout << "============================================\n";
+    cout << left << setw(22) << "Ruta" << right << setw(12) << "Coinciden"
+         << setw(12) << "ns/dígito" << setw(16) << "dígitos/s" << endl;
+    
+    size_t n = digitos.size();
+    medir_ruta("double", repeticiones, n, referencia,
+               [&](size_t d) { return red.predecir(digitos[d]); });
+    medir_ruta("float32", repeticiones, n, referencia,
+               [&](size_t d) { return red_f32.predecir(digitos_f32[d]); });
+    medir_ruta("float32 bits", repeticiones, n, referencia,
+               [&](size_t d) { return red_f32.predecir_bits(digitos_bits[d]); });
+    medir_ruta("int8", repeticiones, n, referencia,
+               [&](size_t d) { return red_int8.predecir(digitos[d]); });
+    medir_ruta("int8 bits", repeticiones, n, referencia,
+               [&](size_t d) { return red_int8.predecir_bits(digitos_bits[d]); });
+    cout << "============================================\n";
+}
 
-// ==================== FUNCIONES DE CLASIFICACIÓN ====================
-// Determina las clases a las que pertenece un número
-vector<int> obtener_clases(int numero) {
-    vector<int> clases;
+// ==================== COMPARACIÓN DE OPTIMIZADORES ====================
+// Entrena redes nuevas con la misma semilla y distintos optimizadores y
+// reporta las épocas necesarias para alcanzar el error objetivo y el tiempo.
+void comparar_optimizadores(const vector<vector<double>>& datos, const vector<vector<double>>& objetivos,
+                            double error_objetivo = 0.01) {
+    struct Variante {
+        string nombre;
+        ConfigEntrenamiento config;
+    };
     
-    // Clase 0: Pares
-    if (numero % 2 == 0) clases.push_back(0);
+    ConfigEntrenamiento base;
+    base.mostrar_progreso = false;
     
-    // Clase 1: Impares
-    if (numero % 2 == 1) clases.push_back(1);
+    ConfigEntrenamiento con_parada = base;
+    con_parada.error_objetivo = error_objetivo;
+    con_parada.paciencia = 500;
     
-    // Clase 2: Primos (2, 3, 5, 7)
-    if (numero == 2 || numero == 3 || numero == 5 || numero == 7) {
-        clases.push_back(2);
-    }
+    vector<Variante> variantes;
+    variantes.push_back({"SGD (actual)", base});
+    variantes.push_back({"SGD + parada", con_parada});
     
-    // Clase 3: Compuestos (4, 6, 8, 9)
-    if (numero == 4 || numero == 6 || numero == 8 || numero == 9) {
-        clases.push_back(3);
-    }
+    ConfigEntrenamiento momentum = con_parada;
+    momentum.optimizador = OPT_MOMENTUM;
+    variantes.push_back({"Momentum 0.9", momentum});
+    
+    ConfigEntrenamiento momentum_coseno = momentum;
+    momentum_coseno.calendario = TASA_COSENO;
+    variantes.push_back({"Momentum + coseno", momentum_coseno});
+    
+    ConfigEntrenamiento adam = con_parada;
+    adam.optimizador = OPT_ADAM;
+    adam.tasa_aprendizaje = 0.01;
+    variantes.push_back({"Adam 0.01", adam});
+    
+    ConfigEntrenamiento adam_escalonada = adam;
+    adam_escalonada.calendario = TASA_ESCALONADA;
+    adam_escalonada.paso_calendario = 200;
+    variantes.push_back({"Adam + escalonada", adam_escalonada});
     
-    return clases;
+    cout << "============================================\n";
+    cout << "       COMPARACIÓN DE OPTIMIZADORES\n";
+    cout << "============================================\n";
+    cout << "Error objetivo: " << fixed << setprecision(4) << error_objetivo << "\n";
+    cout << left << setw(20) << "Configuración" << right << setw(8) << "Épocas"
+         << setw(10) << "Objetivo" << setw(12) << "Error" << setw(12) << "Tiempo ms" << endl;
+    
+    for (const Variante& v : variantes) {
+        RedNeuronal red;
+        red.configurar(v.config);
+        ResultadoEntrenamiento r = red.entrenar(datos, objetivos);
+        
+        cout << left << setw(20) << v.nombre << right << setw(8) << r.epocas
+             << setw(10) << (r.epoca_objetivo > 0 ? to_string(r.epoca_objetivo) : string("-"))
+             << setw(12) << fixed << setprecision(6) << r.error_final
+             << setw(12) << setprecision(1) << r.segundos * 1000.0 << endl;
+    }
+    cout << "============================================\n";
 }
 
-// Convierte las clases en un vector objetivo (one-hot encoding modificado)
-vector<double> clases_a_vector(const vector<int>& clases) {
-    vector<double> objetivo(SALIDAS, 0.0);
-    for (int clase : clases) {
-        objetivo[clase] = 1.0;  // Activar las clases correspondientes
+// ==================== CLASIFICACIÓN POR LOTES ====================
+// eje_3 --clasificar [--entrada glifos] [--modelo archivo] [--motor M]
+//       [--hilos N] [--formato-salida texto|csv|json] [--salida archivo]
+// Clasifica todos los glifos de la entrada con un modelo ya entrenado.
+// Cada bloque del lector se reparte en tramos contiguos entre los hilos;
+// cada hilo tiene su propio motor (la carga mapea el checkpoint, así que
+// comparten las páginas de pesos) y los resultados se escriben en el orden
+// de la entrada.
+enum MotorInferencia { MOTOR_DOUBLE, MOTOR_F32, MOTOR_F32_BITS, MOTOR_INT8, MOTOR_INT8_BITS };
+
+bool interpretar_motor(const string& texto, MotorInferencia& motor) {
+    if (texto == "double") motor = MOTOR_DOUBLE;
+    else if (texto == "f32" || texto == "float32") motor = MOTOR_F32;
+    else if (texto == "f32-bits") motor = MOTOR_F32_BITS;
+    else if (texto == "int8") motor = MOTOR_INT8;
+    else if (texto == "int8-bits") motor = MOTOR_INT8_BITS;
+    else {
+        cerr << "Error: Motor desconocido: " << texto << " (double, f32, f32-bits, int8 o int8-bits)" << endl;
+        return false;
     }
-    return objetivo;
+    return true;
 }
 
-// Interpreta la salida de la red
-vector<int> interpretar_salida(const vector<double>& salida, double umbral = 0.5) {
-    vector<int> clases_predichas;
-    for (int i = 0; i < SALIDAS; ++i) {
-        if (salida[i] > umbral) {
-            clases_predichas.push_back(i);
+// Red de un hilo y, si el motor lo pide, su copia en float32 o int8
+class MotorHilo {
+private:
+    MotorInferencia motor;
+    RedNeuronal red;
+    unique_ptr<RedNeuronalF32> red_f32;
+    unique_ptr<RedNeuronalInt8> red_int8;
+    vector<float> entrada_f32;
+
+public:
+    explicit MotorHilo(MotorInferencia tipo) : motor(tipo) {}
+    
+    bool cargar(const string& archivo_modelo) {
+        if (!red.cargar(archivo_modelo) || !red.entrenamiento_finalizado()) return false;
+        if (motor == MOTOR_F32 || motor == MOTOR_F32_BITS) red_f32.reset(new RedNeuronalF32(red));
+        if (motor == MOTOR_INT8 || motor == MOTOR_INT8_BITS) red_int8.reset(new RedNeuronalInt8(red));
+        return true;
+    }
+    
+    vector<double> predecir(const vector<double>& glifo) {
+        switch (motor) {
+            case MOTOR_F32:
+                entrada_f32.assign(glifo.begin(), glifo.end());
+                return red_f32->predecir(entrada_f32);
+            case MOTOR_F32_BITS: return red_f32->predecir_bits(empaquetar_entrada(glifo));
+            case MOTOR_INT8: return red_int8->predecir(glifo);
+            case MOTOR_INT8_BITS: return red_int8->predecir_bits(empaquetar_entrada(glifo));
+            default: return red.predecir(glifo);
         }
     }
-    return clases_predichas;
+};
+
+struct ResultadoGlifo {
+    vector<double> salida;
+    vector<int> clases;
+    bool correcto;
+};
+
+void escribir_resultado(ostream& salida, uint64_t indice, int etiqueta, const ResultadoGlifo& r,
+                        FormatoSalida formato, bool primero) {
+    if (formato == SALIDA_CSV) {
+        salida << indice << "," << etiqueta;
+        for (double v : r.salida) salida << "," << fixed << setprecision(4) << v;
+        salida << ",";
+        for (size_t i = 0; i < r.clases.size(); ++i) salida << (i ? "|" : "") << nombre_clase(r.clases[i]);
+        salida << "," << (r.correcto ? 1 : 0) << "\n";
+    } else if (formato == SALIDA_JSON) {
+        salida << (primero ? "" : ",\n") << "  {\"indice\": " << indice << ", \"digito\": " << etiqueta
+               << ", \"salida\": [";
+        for (size_t i = 0; i < r.salida.size(); ++i) salida << (i ? ", " : "") << fixed << setprecision(4) << r.salida[i];
+        salida << "], \"clases\": [";
+        for (size_t i = 0; i < r.clases.size(); ++i) salida << (i ? ", " : "") << "\"" << nombre_clase(r.clases[i]) << "\"";
+        salida << "], \"correcto\": " << (r.correcto ? "true" : "false") << "}";
+    } else {
+        salida << indice << " (dígito " << etiqueta << "): ";
+        if (r.clases.empty()) salida << "Ninguna";
+        for (size_t i = 0; i < r.clases.size(); ++i) salida << (i ? ", " : "") << nombre_clase(r.clases[i]);
+        salida << (r.correcto ? "  ✓" : "  ✗") << "\n";
+    }
 }
 
-// ==================== CARGA DE DATOS ====================
-// Lee los dígitos desde el archivo digitos.txt
-vector<vector<double>> cargar_digitos(const string& nombre_archivo) {
-    ifstream archivo(nombre_archivo);
-    if (!archivo.is_open()) {
-        cerr << "Error: No se pudo abrir el archivo " << nombre_archivo << endl;
-        return {};
+int ejecutar_clasificacion(const Argumentos& argumentos, const string& archivo_digitos,
+                           const string& archivo_modelo) {
+    FormatoSalida formato = SALIDA_TEXTO;
+    MotorInferencia motor = MOTOR_DOUBLE;
+    if (!interpretar_formato(argumentos.obtener("formato-salida", "texto"), formato)) return 1;
+    if (!interpretar_motor(argumentos.obtener("motor", "double"), motor)) return 1;
+    bool silencioso = argumentos.bandera("silencioso");
+    
+    int hilos = 1;
+    if (!argumentos.obtener_entero("hilos", hilos)) return 1;
+    if (hilos <= 0) hilos = max(1u, thread::hardware_concurrency());
+    
+    vector<unique_ptr<MotorHilo>> motores;
+    for (int h = 0; h < hilos; ++h) {
+        motores.emplace_back(new MotorHilo(motor));
+        if (!motores.back()->cargar(archivo_modelo)) {
+            cerr << "Error: Se requiere un modelo entrenado en " << archivo_modelo
+                 << " (ejecute primero el programa sin argumentos)\n";
+            return 1;
+        }
+    }
+    
+    unique_ptr<LectorGlifos> lector = abrir_lector_glifos(archivo_digitos);
+    if (!lector) return 1;
+    
+    ofstream archivo_salida;
+    if (argumentos.tiene("salida")) {
+        archivo_salida.open(argumentos.obtener("salida"));
+        if (!archivo_salida.is_open()) {
+            cerr << "Error: No se pudo crear el archivo " << argumentos.obtener("salida") << endl;
+            return 1;
+        }
     }
+    ostream& salida = argumentos.tiene("salida") ? archivo_salida : cout;
     
-    vector<vector<double>> digitos;
-    vector<double> digito_actual;
+    if (formato == SALIDA_CSV) {
+        salida << "indice,digito";
+        for (int k = 0; k < SALIDAS; ++k) salida << ",salida_" << k;
+        salida << ",clases,correcto\n";
+    } else if (formato == SALIDA_JSON) {
+        salida << "[\n";
+    }
     
-    int valor;
-    int contador = 0;
+    BloqueDatos bloque;
+    vector<ResultadoGlifo> resultados(GLIFOS_POR_BLOQUE);
+    uint64_t procesados = 0;
+    uint64_t correctos = 0;
+    double segundos_computo = 0.0;
+    auto inicio = chrono::high_resolution_clock::now();
     
-    // Leer todos los valores del archivo
-    while (archivo >> valor) {
-        digito_actual.push_back(static_cast<double>(valor));
-        contador++;
+    while (lector->leer_bloque(bloque, GLIFOS_POR_BLOQUE)) {
+        auto inicio_bloque = chrono::high_resolution_clock::now();
+        auto clasificar_tramo = [&](int h) {
+            size_t desde = bloque.cantidad * h / hilos;
+            size_t hasta = bloque.cantidad * (h + 1) / hilos;
+            for (size_t i = desde; i < hasta; ++i) {
+                ResultadoGlifo& r = resultados[i];
+                r.salida = motores[h]->predecir(bloque.glifos[i]);
+                r.clases = interpretar_salida(r.salida, 0.5);
+                r.correcto = r.clases == obtener_clases(bloque.etiquetas[i] % 10);
+            }
+        };
+        vector<thread> trabajadores;
+        for (int h = 1; h < hilos; ++h) trabajadores.emplace_back(clasificar_tramo, h);
+        clasificar_tramo(0);
+        for (thread& t : trabajadores) t.join();
+        segundos_computo += chrono::duration<double>(chrono::high_resolution_clock::now() - inicio_bloque).count();
         
-        // Cada dígito tiene 35 valores (7 filas x 5 columnas)
-        if (contador == ENTRADAS) {
-            digitos.push_back(digito_actual);
-            digito_actual.clear();
-            contador = 0;
+        for (size_t i = 0; i < bloque.cantidad; ++i) {
+            escribir_resultado(salida, procesados + i, bloque.etiquetas[i] % 10, resultados[i], formato,
+                               procesados + i == 0);
+            if (resultados[i].correcto) correctos++;
         }
+        procesados += bloque.cantidad;
     }
+    if (formato == SALIDA_JSON) salida << (procesados > 0 ? "\n" : "") << "]\n";
     
-    archivo.close();
-    cout << "Cargados " << digitos.size() << " dígitos desde " << nombre_archivo << endl;
-    return digitos;
+    double segundos = chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+    if (!silencioso) {
+        cerr << fixed << setprecision(2)
+             << procesados << " glifos clasificados con " << argumentos.obtener("motor", "double")
+             << " y " << hilos << " hilo(s): " << correctos << " correctos ("
+             << (procesados > 0 ? 100.0 * correctos / procesados : 0.0) << "%)\n"
+             << "Tiempo total: " << setprecision(3) << segundos << " s (cómputo " << segundos_computo
+             << " s, " << setprecision(0) << (segundos_computo > 0 ? procesados / segundos_computo : 0.0)
+             << " glifos/s)\n";
+    }
+    return 0;
 }
 
-// ==================== VISUALIZACIÓN ====================
-// Muestra un dígito en formato ASCII
-void mostrar_digito(const vector<double>& digito) {
-    for (int i = 0; i < FILAS_DIGITO; ++i) {
-        for (int j = 0; j < COLS_DIGITO; ++j) {
-            int idx = i * COLS_DIGITO + j;
-            cout << (digito[idx] > 0.5 ? "█" : " ") << " ";
+// ==================== VALIDACIÓN CRUZADA ====================
+// eje_3 --validacion-cruzada [--entrada glifos] [--pliegues K]
+//       [--busqueda rejilla|aleatoria] [--muestras N] [--ocultas 10,20,40]
+//       [--tasas 0.05,0.1] [--epocas 1000,5000] [--semillas 1,2,3]
+//       [--semilla-particion S] [--hilos N] [--formato-salida F] [--salida archivo]
+// Evalúa cada configuración en datos que no vio al entrenar, en lugar de
+// medir la precisión sobre los mismos dígitos de entrenamiento.
+void escribir_busqueda(ostream& salida, const ResultadoBusqueda& r, FormatoSalida formato) {
+    if (formato == SALIDA_CSV) {
+        salida << "neuronas_oculta,tasa_aprendizaje,epocas,semilla,media_validacion,"
+                  "desviacion_validacion,media_entrenamiento,ms_entrenamiento\n";
+        for (const ResultadoConfiguracion& c : r.configuraciones) {
+            salida << c.parametros.neuronas_oculta << "," << setprecision(6) << defaultfloat
+                   << c.parametros.tasa_aprendizaje << "," << c.parametros.epocas << "," << c.parametros.semilla
+                   << "," << fixed << setprecision(2) << c.media_validacion << "," << c.desviacion_validacion
+                   << "," << c.media_entrenamiento << "," << setprecision(1) << c.segundos_entrenamiento * 1000.0 << "\n";
         }
-        cout << endl;
+        return;
+    }
+    if (formato == SALIDA_JSON) {
+        salida << "{\n  \"entrenamientos\": " << r.entrenamientos << ", \"hilos\": " << r.hilos
+               << ", \"segundos\": " << fixed << setprecision(3) << r.segundos << ",\n  \"configuraciones\": [";
+        for (size_t i = 0; i < r.configuraciones.size(); ++i) {
+            const ResultadoConfiguracion& c = r.configuraciones[i];
+            salida << (i ? "," : "") << "\n    {\"neuronas_oculta\": " << c.parametros.neuronas_oculta
+                   << ", \"tasa_aprendizaje\": " << setprecision(6) << defaultfloat << c.parametros.tasa_aprendizaje
+                   << ", \"epocas\": " << c.parametros.epocas << ", \"semilla\": " << c.parametros.semilla
+                   << fixed << setprecision(2) << ", \"media_validacion\": " << c.media_validacion
+                   << ", \"desviacion_validacion\": " << c.desviacion_validacion
+                   << ", \"media_entrenamiento\": " << c.media_entrenamiento
+                   << ", \"ms_entrenamiento\": " << setprecision(1) << c.segundos_entrenamiento * 1000.0 << "}";
+        }
+        salida << "\n  ]\n}\n";
+        return;
     }
+
+    salida << "============================================\n";
+    salida << "   VALIDACIÓN CRUZADA - HIPERPARÁMETROS\n";
+    salida << "============================================\n";
+    salida << left << setw(8) << "Ocultas" << right << setw(10) << "Tasa" << setw(8) << "Épocas"
+           << setw(9) << "Semilla" << setw(12) << "Valid. %" << setw(9) << "± desv"
+           << setw(12) << "Entren. %" << setw(12) << "ms/pliegue" << endl;
+    for (const ResultadoConfiguracion& c : r.configuraciones) {
+        salida << left << setw(8) << c.parametros.neuronas_oculta << right
+               << setw(10) << setprecision(4) << defaultfloat << c.parametros.tasa_aprendizaje
+               << setw(8) << c.parametros.epocas << setw(9) << c.parametros.semilla
+               << fixed << setprecision(2) << setw(12) << c.media_validacion << setw(9) << c.desviacion_validacion
+               << setw(12) << c.media_entrenamiento << setw(12) << setprecision(1)
+               << c.segundos_entrenamiento * 1000.0 << endl;
+    }
+    salida << "============================================\n";
 }
 
-// Convierte clases en nombres descriptivos
-string nombre_clase(int clase) {
-    switch(clase) {
-        case 0: return "Par";
-        case 1: return "Impar";
-        case 2: return "Primo";
-        case 3: return "Compuesto";
-        default: return "Desconocido";
+int ejecutar_validacion(const Argumentos& argumentos, const string& archivo_digitos) {
+    FormatoSalida formato = SALIDA_TEXTO;
+    ConfigBusqueda config;
+    if (!interpretar_formato(argumentos.obtener("formato-salida", "texto"), formato)) return 1;
+    if (!interpretar_busqueda(argumentos.obtener("busqueda", "rejilla"), config.tipo)) return 1;
+    if (!argumentos.obtener_lista("ocultas", config.neuronas_oculta)
+        || !argumentos.obtener_lista("tasas", config.tasas)
+        || !argumentos.obtener_lista("epocas", config.epocas)
+        || !argumentos.obtener_lista("semillas", config.semillas)) {
+        return 1;
+    }
+    int semilla_particion = static_cast<int>(config.semilla_particion);
+    if (!argumentos.obtener_entero("pliegues", config.pliegues)
+        || !argumentos.obtener_entero("muestras", config.muestras)
+        || !argumentos.obtener_entero("semilla-particion", semilla_particion)
+        || !argumentos.obtener_entero("hilos", config.hilos)) {
+        return 1;
+    }
+    config.semilla_particion = static_cast<unsigned>(semilla_particion);
+    if (!leer_opciones_entrenamiento(argumentos, config.entrenamiento)) return 1;
+    bool silencioso = argumentos.bandera("silencioso");
+
+    for (double n : config.neuronas_oculta) {
+        if (n < 1) { cerr << "Error: --ocultas requiere valores >= 1\n"; return 1; }
+    }
+    for (double t : config.tasas) {
+        if (t <= 0) { cerr << "Error: --tasas requiere valores > 0\n"; return 1; }
+    }
+    for (double e : config.epocas) {
+        if (e < 1) { cerr << "Error: --epocas requiere valores >= 1\n"; return 1; }
+    }
+    if (config.muestras < 1) {
+        cerr << "Error: --muestras debe ser >= 1\n";
+        return 1;
+    }
+
+    DatosEtiquetados datos;
+    if (!cargar_glifos_etiquetados(archivo_digitos, datos)) return 1;
+    if (config.pliegues < 2 || static_cast<size_t>(config.pliegues) > datos.glifos.size()) {
+        cerr << "Error: --pliegues debe estar entre 2 y el número de glifos (" << datos.glifos.size() << ")\n";
+        return 1;
+    }
+
+    ofstream archivo_salida;
+    if (argumentos.tiene("salida")) {
+        archivo_salida.open(argumentos.obtener("salida"));
+        if (!archivo_salida.is_open()) {
+            cerr << "Error: No se pudo crear el archivo " << argumentos.obtener("salida") << endl;
+            return 1;
+        }
+    }
+    ostream& salida = argumentos.tiene("salida") ? archivo_salida : cout;
+
+    ResultadoBusqueda resultado = buscar_hiperparametros(datos, config);
+    escribir_busqueda(salida, resultado, formato);
+
+    if (!silencioso && !resultado.configuraciones.empty()) {
+        const ResultadoConfiguracion& mejor = resultado.configuraciones.front();
+        cerr << fixed << setprecision(3)
+             << datos.glifos.size() << " glifos, " << config.pliegues << " pliegues, "
+             << resultado.configuraciones.size() << " configuraciones: " << resultado.entrenamientos
+             << " entrenamientos en " << resultado.hilos << " hilo(s), " << resultado.segundos << " s\n"
+             << "Mejor: " << mejor.parametros.neuronas_oculta << " ocultas, tasa "
+             << setprecision(4) << defaultfloat << mejor.parametros.tasa_aprendizaje << ", "
+             << mejor.parametros.epocas << " épocas, semilla " << mejor.parametros.semilla << " -> "
+             << fixed << setprecision(2) << mejor.media_validacion << "% ± " << mejor.desviacion_validacion << "%\n";
     }
+    return 0;
 }
 
-// ==================== FUNCIÓN PRINCIPAL ====================
-int main() {
+// ==================== CONVERSIÓN A BINARIO ====================
+// eje_3 --convertir destino.glb [--entrada origen]
+int ejecutar_conversion(const Argumentos& argumentos, const string& archivo_digitos) {
+    string destino = argumentos.obtener("convertir");
+    if (destino.empty() || destino == "true") {
+        cerr << "Error: --convertir requiere el archivo de destino\n";
+        return 1;
+    }
+    
+    auto inicio = chrono::high_resolution_clock::now();
+    if (!convertir_a_binario(archivo_digitos, destino)) return 1;
+    double segundos = chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+    
+    if (!argumentos.bandera("silencioso")) {
+        CabeceraGlifos cabecera = {};
+        ifstream(destino, ios::binary).read(reinterpret_cast<char*>(&cabecera), sizeof(cabecera));
+        cerr << "Convertido " << archivo_digitos << " -> " << destino << " (" << cabecera.cantidad
+             << " glifos, " << fixed << setprecision(3) << segundos << " s)\n";
+    }
+    return 0;
+}
 
-    // Activar UTF-8 en Windows para caracteres especiales  
-    SetConsoleOutputCP(CP_UTF8);
+// ==================== MODO SERVICIO ====================
+// eje_3 --servicio <archivo | unix:/ruta> [--salida archivo] [--hilos N]
+//       [--plazo-ms X] [--lote-max N] [--modelo archivo]
+// Requiere un modelo ya entrenado (el servicio lo comprueba al cargarlo).
+int ejecutar_servicio(const Argumentos& argumentos, const string& archivo_modelo) {
+    ConfigServicio config;
+    config.entrada = argumentos.obtener("servicio");
+    config.salida = argumentos.obtener("salida");
+    int lote_maximo = static_cast<int>(config.lote_maximo);
+    if (!argumentos.obtener_entero("hilos", config.hilos)
+        || !argumentos.obtener_real("plazo-ms", config.plazo_ms)
+        || !argumentos.obtener_entero("lote-max", lote_maximo)) {
+        return 1;
+    }
+    if (lote_maximo < 1) {
+        cerr << "Error: --lote-max debe ser >= 1\n";
+        return 1;
+    }
+    config.lote_maximo = static_cast<size_t>(lote_maximo);
+    if (config.entrada.empty()) {
+        cerr << "Error: --servicio requiere un archivo de glifos o unix:/ruta\n";
+        return 1;
+    }
+    
+    return ejecutar_servicio_inferencia(config, archivo_modelo);
+}
 
-    cout << "============================================\n";
-    cout << "  RED NEURONAL - CLASIFICACIÓN DE DÍGITOS\n";
-    cout << "============================================\n\n";
+// ==================== DEMOSTRACIÓN COMPLETA ====================
+// Entrena (o reanuda) la red, clasifica los dígitos 0-9 y compara rutas de
+// inferencia y optimizadores. Con --silencioso solo se muestran las
+// estadísticas finales. Con --aumentar el entrenamiento en memoria usa
+// variantes generadas en línea en lugar de los glifos tal cual. Las
+// opciones de entrenamiento se aplican sobre la configuración del
+// checkpoint si se reanuda.
+int ejecutar_demostracion(const Argumentos& argumentos, const string& archivo_digitos,
+                          const string& archivo_modelo) {
+    bool silencioso = argumentos.bandera("silencioso");
+    bool aumentar = argumentos.bandera("aumentar");
+    ConfigAumento config_aumento;
+    int semilla_aumento = static_cast<int>(config_aumento.semilla);
+    if (!argumentos.obtener_entero("variantes", config_aumento.variantes)
+        || !argumentos.obtener_real("prob-inversion", config_aumento.prob_inversion)
+        || !argumentos.obtener_real("prob-desplazamiento", config_aumento.prob_desplazamiento)
+        || !argumentos.obtener_real("prob-engrosamiento", config_aumento.prob_engrosamiento)
+        || !argumentos.obtener_entero("semilla-aumento", semilla_aumento)) {
+        return 1;
+    }
+    config_aumento.semilla = static_cast<unsigned>(semilla_aumento);
+    if (!validar_config_aumento(config_aumento)) return 1;
+    
+    // Las opciones se validan antes de cargar nada
+    ConfigEntrenamiento opciones;
+    if (!leer_opciones_entrenamiento(argumentos, opciones)
+        || !argumentos.obtener_real("tasa", opciones.tasa_aprendizaje)
+        || !argumentos.obtener_entero("epocas", opciones.epocas)) {
+        return 1;
+    }
+    
+    if (!silencioso) {
+        cout << "============================================\n";
+        cout << "  RED NEURONAL - CLASIFICACIÓN DE DÍGITOS\n";
+        cout << "============================================\n\n";
+    }
     
     // 1. CARGAR LOS DÍGITOS DEL ARCHIVO
-    vector<vector<double>> digitos = cargar_digitos("digitos.txt");
+    // Un archivo grande no se carga completo: solo los 10 primeros glifos
+    // (0-9) para la evaluación; el entrenamiento lo recorre en flujo
+    ifstream prueba_tamano(archivo_digitos, ios::binary | ios::ate);
+    bool entrenar_en_flujo = prueba_tamano.is_open()
+        && static_cast<uint64_t>(prueba_tamano.tellg()) > LIMITE_CARGA_COMPLETA;
+    prueba_tamano.close();
     
-    if (digitos.size() != 10) {
-        cerr << "Error: Se esperaban 10 dígitos (0-9)\n";
+    vector<vector<double>> digitos = cargar_digitos(
+        archivo_digitos, entrenar_en_flujo ? 10 : numeric_limits<size_t>::max(), silencioso);
+    
+    if (digitos.size() < 10) {
+        cerr << "Error: Se esperaban al menos 10 dígitos (0-9)\n";
         return 1;
     }
     
     // 2. PREPARAR DATOS DE ENTRENAMIENTO
+    // El glifo en la posición i representa al número i % 10
     vector<vector<double>> datos_entrenamiento;
     vector<vector<double>> objetivos_entrenamiento;
+    vector<int> etiquetas;
     
-    for (int numero = 0; numero < 10; ++numero) {
-        datos_entrenamiento.push_back(digitos[numero]);
-        vector<int> clases = obtener_clases(numero);
+    for (size_t i = 0; i < digitos.size(); ++i) {
+        datos_entrenamiento.push_back(digitos[i]);
+        vector<int> clases = obtener_clases(static_cast<int>(i % 10));
         objetivos_entrenamiento.push_back(clases_a_vector(clases));
+        etiquetas.push_back(static_cast<int>(i % 10));
     }
     
     // 3. CREAR Y ENTRENAR LA RED NEURONAL
+    // Si existe un checkpoint se mapea y se usa directamente; si está
+    // incompleto, el entrenamiento continúa desde la época guardada
     RedNeuronal red;
-    red.entrenar(datos_entrenamiento, objetivos_entrenamiento);
+    if (red.cargar(archivo_modelo) && !silencioso) {
+        cout << "Modelo cargado desde " << archivo_modelo
+             << " (época " << red.obtener_epoca() << "/" << red.obtener_config().epocas << ")\n";
+    }
+    if (!red.entrenamiento_finalizado()) {
+        ConfigEntrenamiento config = red.obtener_config();
+        leer_opciones_entrenamiento(argumentos, config);
+        argumentos.obtener_real("tasa", config.tasa_aprendizaje);
+        argumentos.obtener_entero("epocas", config.epocas);
+        config.mostrar_progreso = !silencioso;
+        if (!red.configurar(config)) return 1;
+        if (entrenar_en_flujo) {
+            if (aumentar) cerr << "Aviso: el aumento de datos no se aplica al entrenar en flujo\n";
+            if (!entrenar_desde_archivo(red, archivo_digitos, archivo_modelo, silencioso)) return 1;
+        } else if (aumentar) {
+            entrenar_con_aumento(red, datos_entrenamiento, etiquetas, config_aumento, archivo_modelo);
+        } else {
+            red.entrenar(datos_entrenamiento, objetivos_entrenamiento, archivo_modelo);
+        }
+        red.guardar(archivo_modelo);
+    } else {
+        // --aumentar y --variantes solo afectan al entrenamiento; las
+        // probabilidades y la semilla también definen las variantes de la
+        // evaluación final, así que esas sí se usan
+        bool opciones_ignoradas = aumentar || argumentos.tiene("variantes");
+        for (const string& opcion : OPCIONES_ENTRENAMIENTO) opciones_ignoradas |= argumentos.tiene(opcion);
+        if (opciones_ignoradas) {
+            cerr << "Aviso: " << archivo_modelo << " ya está entrenado; se ignoran las opciones de "
+                 << "entrenamiento y de aumento (use otro --modelo para entrenar de nuevo)\n";
+        }
+        if (!silencioso) cout << endl;
+    }
     
     // 4. PROBAR LA RED CON TODOS LOS DÍGITOS
-    cout << "============================================\n";
-    cout << "        RESULTADOS DE CLASIFICACIÓN\n";
-    cout << "============================================\n\n";
+    if (!silencioso) {
+        cout << "============================================\n";
+        cout << "        RESULTADOS DE CLASIFICACIÓN\n";
+        cout << "============================================\n\n";
+    }
     
     int correctos = 0;
     int total = 0;
     
     for (int numero = 0; numero < 10; ++numero) {
-        cout << "Dígito " << numero << ":\n";
-        mostrar_digito(digitos[numero]);
-        
         // Predecir
         vector<double> salida = red.predecir(digitos[numero]);
         vector<int> clases_predichas = interpretar_salida(salida, 0.5);
         vector<int> clases_reales = obtener_clases(numero);
         
+        // Verificar si la predicción es correcta
+        bool correcto = (clases_predichas == clases_reales);
+        total += clases_reales.size();
+        
+        for (int clase : clases_reales) {
+            if (find(clases_predichas.begin(), clases_predichas.end(), clase) 
+                != clases_predichas.end()) {
+                correctos++;
+            }
+        }
+        
+        if (silencioso) continue;
+        
         // Mostrar resultados
+        cout << "Dígito " << numero << ":\n";
+        mostrar_digito(digitos[numero]);
+        
         cout << "\nSalida de la red: ";
         for (int i = 0; i < SALIDAS; ++i) {
             cout << fixed << setprecision(2) << salida[i] << " ";
@@ -379,17 +727,6 @@ int main() {
         }
         cout << endl;
         
-        // Verificar si la predicción es correcta
-        bool correcto = (clases_predichas == clases_reales);
-        total += clases_reales.size();
-        
-        for (int clase : clases_reales) {
-            if (find(clases_predichas.begin(), clases_predichas.end(), clase) 
-                != clases_predichas.end()) {
-                correctos++;
-            }
-        }
-        
         cout << (correcto ? "✓ CORRECTO" : "✗ INCORRECTO") << "\n";
         cout << "--------------------------------------------\n\n";
     }
@@ -401,7 +738,107 @@ int main() {
     cout << "============================================\n";
     cout << "Clasificaciones correctas: " << correctos << "/" << total << endl;
     cout << "Precisión: " << fixed << setprecision(2) << precision << "%\n";
-    cout << "============================================\n";
+    
+    // Variantes con otra semilla que la del aumento: entradas que la red
+    // no vio, con o sin aumento en el entrenamiento
+    ConfigAumento config_evaluacion = config_aumento;
+    config_evaluacion.semilla = config_aumento.semilla + 1;
+    cout << "Precisión en " << VARIANTES_EVALUACION << " variantes no vistas: " << fixed << setprecision(2)
+         << precision_con_aumento(red, vector<vector<double>>(digitos.begin(), digitos.begin() + 10),
+                                  vector<int>(etiquetas.begin(), etiquetas.begin() + 10),
+                                  config_evaluacion, VARIANTES_EVALUACION) << "%\n";
+    cout << "============================================\n\n";
+    
+    if (silencioso) return 0;
+    
+    // 6. COMPARAR RUTAS DE INFERENCIA (double, float32, int8, bits)
+    comparar_rutas_inferencia(red, digitos);
+    cout << endl;
+    
+    // 7. COMPARAR OPTIMIZADORES Y PARADA TEMPRANA
+    if (!entrenar_en_flujo) {
+        comparar_optimizadores(datos_entrenamiento, objetivos_entrenamiento);
+    }
     
     return 0;
-}
\ No newline at end of file
+}
+
+// ==================== FUNCIÓN PRINCIPAL ====================
+// Sin opciones se ejecuta la demostración completa con los archivos por
+// defecto; --servicio, --clasificar y --validacion-cruzada seleccionan los
+// modos sin interfaz.
+int main(int argc, char* argv[]) {
+
+#ifdef _WIN32
+    // Activar UTF-8 en Windows para caracteres especiales  
+    SetConsoleOutputCP(CP_UTF8);
+#endif
+    
+    Argumentos argumentos({
+        {"entrada", "input", true, "Archivo de glifos (por defecto digitos.txt)"},
+        {"modelo", "model", true, "Checkpoint de la red (por defecto modelo_digitos.rnc)"},
+        {"silencioso", "quiet", false, "Solo estadísticas finales"},
+        {"clasificar", "classify", false, "Clasifica toda la entrada con el modelo entrenado"},
+        {"motor", "engine", true, "Ruta de inferencia: double, f32, f32-bits, int8 o int8-bits"},
+        {"formato-salida", "output-format", true, "texto, csv o json (con --clasificar o --validacion-cruzada)"},
+        {"convertir", "convert", true, "Convierte la entrada al formato binario .glb en el archivo indicado"},
+        {"servicio", "serve", true, "Servicio de inferencia sobre un archivo o unix:/ruta"},
+        {"salida", "output", true, "Archivo de resultados (por defecto, la consola)"},
+        {"hilos", "threads", true, "Hilos de clasificación o de validación (0 = todos los núcleos)"},
+        {"plazo-ms", "deadline-ms", true, "Latencia objetivo por glifo del servicio"},
+        {"lote-max", "max-batch", true, "Tamaño máximo de micro-lote del servicio"},
+        {"validacion-cruzada", "cross-validate", false, "Validación cruzada y búsqueda de hiperparámetros"},
+        {"pliegues", "folds", true, "Pliegues de la validación cruzada (por defecto 5)"},
+        {"busqueda", "search", true, "rejilla o aleatoria"},
+        {"muestras", "samples", true, "Configuraciones de la búsqueda aleatoria (por defecto 20)"},
+        {"ocultas", "hidden", true, "Neuronas ocultas, separadas por comas (10,20,40)"},
+        {"tasas", "rates", true, "Tasas de aprendizaje, separadas por comas"},
+        {"epocas", "epochs", true, "Épocas de entrenamiento (en la validación cruzada, separadas por comas)"},
+        {"semillas", "seeds", true, "Semillas de inicialización, separadas por comas"},
+        {"semilla-particion", "split-seed", true, "Semilla del reparto en pliegues y del muestreo"},
+        {"optimizador", "optimizer", true, "sgd, momentum o adam (por defecto sgd)"},
+        {"tasa", "learning-rate", true, "Tasa de aprendizaje del entrenamiento (por defecto 0.1)"},
+        {"momento", "momentum", true, "Momento de Momentum (por defecto 0.9)"},
+        {"beta1", "", true, "Adam: decaimiento de la media de gradientes (por defecto 0.9)"},
+        {"beta2", "", true, "Adam: decaimiento de la media de cuadrados (por defecto 0.999)"},
+        {"calendario", "schedule", true, "Tasa: constante, escalonada, exponencial o coseno"},
+        {"paso-calendario", "schedule-step", true, "Épocas por reducción de la tasa (por defecto 1000)"},
+        {"factor-calendario", "schedule-factor", true, "Factor de reducción de la tasa (por defecto 0.5)"},
+        {"error-objetivo", "target-error", true, "Parada temprana al alcanzar este error por época"},
+        {"paciencia", "patience", true, "Parada temprana tras N épocas sin mejora"},
+        {"mejora-minima", "min-delta", true, "Mejora mínima que reinicia la paciencia (por defecto 1e-6)"},
+        {"aumentar", "augment", false, "Entrena con variantes generadas en línea (inversiones, desplazamientos, engrosado)"},
+        {"variantes", "variants", true, "Variantes por glifo en cada época (por defecto 8)"},
+        {"prob-inversion", "flip-prob", true, "Probabilidad de invertir cada píxel (por defecto 0.03)"},
+        {"prob-desplazamiento", "shift-prob", true, "Probabilidad de desplazar el glifo un píxel (por defecto 0.5)"},
+        {"prob-engrosamiento", "thicken-prob", true, "Probabilidad de engrosar el trazo (por defecto 0.25)"},
+        {"semilla-aumento", "augment-seed", true, "Semilla del aumento de datos"},
+    });
+    if (!argumentos.analizar(argc, argv)) return 1;
+    if (argumentos.bandera("ayuda")) {
+        argumentos.mostrar_ayuda("eje_3", "Red neuronal de clasificación de dígitos. Sin opciones se ejecuta la demostración completa.");
+        return 0;
+    }
+    
+    string archivo_digitos = argumentos.obtener("entrada", ARCHIVO_DIGITOS);
+    string archivo_modelo = argumentos.obtener("modelo", ARCHIVO_MODELO);
+    
+    if (argumentos.tiene("servicio")) {
+        int codigo = ejecutar_servicio(argumentos, archivo_modelo);
+        INSTRUMENTAR_FINALIZAR("eje_3_servicio");
+        return codigo;
+    }
+    
+    int codigo;
+    if (argumentos.tiene("convertir")) {
+        codigo = ejecutar_conversion(argumentos, archivo_digitos);
+    } else if (argumentos.bandera("validacion-cruzada")) {
+        codigo = ejecutar_validacion(argumentos, archivo_digitos);
+    } else if (argumentos.bandera("clasificar")) {
+        codigo = ejecutar_clasificacion(argumentos, archivo_digitos, archivo_modelo);
+    } else {
+        codigo = ejecutar_demostracion(argumentos, archivo_digitos, archivo_modelo);
+    }
+    INSTRUMENTAR_FINALIZAR("eje_3");
+    return codigo;
+}
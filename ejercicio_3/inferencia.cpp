@@ -0,0 +1,33 @@
+#include "inferencia.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ==================== INFERENCIA CUANTIZADA INT8 ====================
+int32_t producto_punto_u8_s8(const uint8_t* a, const int8_t* b, int n) {
+#if defined(__AVX2__)
+    __m256i acumulador = _mm256_setzero_si256();
+    const __m256i unos = _mm256_set1_epi16(1);
+    for (int i = 0; i < n; i += 32) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        // a ∈ [0,127], b ∈ [-127,127]: la suma de pares cabe en int16 sin saturar
+        __m256i pares = _mm256_maddubs_epi16(va, vb);
+        acumulador = _mm256_add_epi32(acumulador, _mm256_madd_epi16(pares, unos));
+    }
+    __m128i suma = _mm_add_epi32(_mm256_castsi256_si128(acumulador),
+                                 _mm256_extracti128_si256(acumulador, 1));
+    suma = _mm_hadd_epi32(suma, suma);
+    suma = _mm_hadd_epi32(suma, suma);
+    return _mm_cvtsi128_si32(suma);
+#else
+    int32_t suma = 0;
+    for (int i = 0; i < n; ++i) {
+        suma += static_cast<int32_t>(a[i]) * static_cast<int32_t>(b[i]);
+    }
+    return suma;
+#endif
+}
@@ -0,0 +1,252 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - RUTAS DE INFERENCIA
+// ============================================================================
+// Copias de solo inferencia de una RedNeuronal entrenada: float32 (con
+// entradas densas o empaquetadas en bits) e int8 cuantizado.
+// ============================================================================
+
+#ifndef INFERENCIA_H
+#define INFERENCIA_H
+
+#include "red_neuronal.h"
+
+using namespace std;
+
+// ==================== INFERENCIA EN FLOAT32 ====================
+// Copia en precisión simple de una red ya entrenada. Los pesos se guardan
+// en bloques contiguos [fila][columna] para que los bucles internos se
+// vectoricen (cada entrada suma una fila completa de pesos).
+class RedNeuronalF32 {
+private:
+    int entradas;
+    int neuronas_oculta;
+    int salidas;
+    
+    vector<float> pesos_entrada_oculta;   // [entradas * neuronas_oculta]
+    vector<float> pesos_oculta_salida;    // [neuronas_oculta * salidas]
+    vector<float> sesgo_oculta;           // [neuronas_oculta]
+    vector<float> sesgo_salida;           // [salidas]
+    
+    vector<float> activacion_oculta;      // [neuronas_oculta]
+    vector<float> suma_salida;            // [salidas]
+    
+    static float sigmoide_f(float x) {
+        return 1.0f / (1.0f + exp(-x));
+    }
+    
+    // Capa oculta -> salida (común a la ruta densa y a la de bits)
+    vector<double> capa_salida() {
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            activacion_oculta[j] = sigmoide_f(activacion_oculta[j]);
+        }
+        
+        copy(sesgo_salida.begin(), sesgo_salida.end(), suma_salida.begin());
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            const float* fila = &pesos_oculta_salida[j * salidas];
+            for (int k = 0; k < salidas; ++k) {
+                suma_salida[k] += activacion_oculta[j] * fila[k];
+            }
+        }
+        
+        vector<double> salida(salidas);
+        for (int k = 0; k < salidas; ++k) salida[k] = sigmoide_f(suma_salida[k]);
+        return salida;
+    }
+
+public:
+    explicit RedNeuronalF32(const RedNeuronal& red)
+        : entradas(red.obtener_entradas()), neuronas_oculta(red.obtener_neuronas_oculta()),
+          salidas(red.obtener_salidas()),
+          pesos_entrada_oculta(red.obtener_pesos_entrada_oculta(),
+                               red.obtener_pesos_entrada_oculta() + entradas * neuronas_oculta),
+          pesos_oculta_salida(red.obtener_pesos_oculta_salida(),
+                              red.obtener_pesos_oculta_salida() + neuronas_oculta * salidas),
+          sesgo_oculta(red.obtener_sesgo_oculta(), red.obtener_sesgo_oculta() + neuronas_oculta),
+          sesgo_salida(red.obtener_sesgo_salida(), red.obtener_sesgo_salida() + salidas),
+          activacion_oculta(neuronas_oculta), suma_salida(salidas) {}
+    
+    // Ruta densa: acumula entrada[i] * fila_i para cada píxel
+    vector<double> predecir(const vector<float>& entrada) {
+        copy(sesgo_oculta.begin(), sesgo_oculta.end(), activacion_oculta.begin());
+        for (int i = 0; i < entradas; ++i) {
+            const float x = entrada[i];
+            const float* fila = &pesos_entrada_oculta[i * neuronas_oculta];
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                activacion_oculta[j] += x * fila[j];
+            }
+        }
+        return capa_salida();
+    }
+    
+    // Ruta rápida para entradas binarias: la primera capa se reduce a la
+    // suma de las filas de pesos de los píxeles encendidos
+    vector<double> predecir_bits(const EntradaBits& entrada) {
+        copy(sesgo_oculta.begin(), sesgo_oculta.end(), activacion_oculta.begin());
+        for (size_t w = 0; w < entrada.size(); ++w) {
+            uint64_t palabra = entrada[w];
+            while (palabra != 0) {
+                int i = static_cast<int>(w * 64) + __builtin_ctzll(palabra);
+                palabra &= palabra - 1;   // Apagar el bit menos significativo
+                const float* fila = &pesos_entrada_oculta[i * neuronas_oculta];
+                for (int j = 0; j < neuronas_oculta; ++j) {
+                    activacion_oculta[j] += fila[j];
+                }
+            }
+        }
+        return capa_salida();
+    }
+};
+
+// ==================== INFERENCIA CUANTIZADA INT8 ====================
+// Cuantización post-entrenamiento simétrica con una escala por capa:
+//   w ≈ escala * w_q,   w_q ∈ [-127, 127]
+// Las entradas binarias se representan exactamente (0/1) y las
+// activaciones ocultas como h_q = round(127 * h) ∈ [0, 127]. Los sesgos
+// se guardan en int32 en la escala del acumulador de cada capa.
+
+// Redondea una longitud al siguiente múltiplo de 32 (ancho de registro AVX2)
+inline int alinear_32(int n) { return (n + 31) & ~31; }
+
+// Producto punto u8 x s8 con acumulación en int32. Con AVX2 usa
+// maddubs/madd (32 productos por iteración); en otro caso un bucle escalar
+// que el compilador puede vectorizar. Ambos vectores deben tener una
+// longitud múltiplo de 32 (relleno con ceros).
+int32_t producto_punto_u8_s8(const uint8_t* a, const int8_t* b, int n);
+
+class RedNeuronalInt8 {
+private:
+    int entradas;
+    int neuronas_oculta;
+    int salidas;
+    
+    // Pesos transpuestos [neurona][entrada] con relleno hasta múltiplo de 32
+    int ancho_entrada;   // alinear_32(entradas)
+    int ancho_oculta;    // alinear_32(neuronas_oculta)
+    vector<int8_t> pesos_oculta;    // [neuronas_oculta][ancho_entrada]
+    vector<int8_t> pesos_salida;    // [salidas][ancho_oculta]
+    vector<int8_t> filas_entrada;   // [entradas][ancho_oculta], para la ruta de bits
+    vector<int32_t> sesgo_oculta;   // escala: escala_oculta
+    vector<int32_t> sesgo_salida;   // escala: escala_salida / 127
+    float escala_oculta;
+    float escala_salida;
+    
+    vector<uint8_t> entrada_q;      // [ancho_entrada]
+    vector<uint8_t> oculta_q;       // [ancho_oculta]
+    vector<int32_t> acumulador;     // [ancho_oculta]
+    vector<int16_t> parcial;        // [ancho_oculta], sumas de la ruta de bits
+    
+    // Filas sumables en int16 sin desbordar: 258 * 127 <= 32767
+    static const int FILAS_POR_VOLCADO = 32767 / 127;
+    
+    static float escala_simetrica(const double* w, size_t n) {
+        double maximo = 0.0;
+        for (size_t i = 0; i < n; ++i) maximo = max(maximo, abs(w[i]));
+        return maximo > 0.0 ? static_cast<float>(maximo / 127.0) : 1.0f;
+    }
+    
+    static int8_t cuantizar(double valor, float escala) {
+        long q = lround(valor / escala);
+        return static_cast<int8_t>(max(-127L, min(127L, q)));
+    }
+    
+    // Activación oculta cuantizada a partir del acumulador int32 de la neurona
+    uint8_t activar_oculta(int32_t acc) const {
+        float h = 1.0f / (1.0f + exp(-escala_oculta * static_cast<float>(acc)));
+        return static_cast<uint8_t>(lround(h * 127.0f));
+    }
+    
+    void volcar_parcial() {
+        for (int j = 0; j < ancho_oculta; ++j) {
+            acumulador[j] += parcial[j];
+            parcial[j] = 0;
+        }
+    }
+    
+    // Capa oculta -> salida (común a la ruta densa y a la de bits)
+    vector<double> capa_salida() {
+        vector<double> salida(salidas);
+        const float escala = escala_salida / 127.0f;
+        for (int k = 0; k < salidas; ++k) {
+            int32_t acc = sesgo_salida[k] + producto_punto_u8_s8(
+                oculta_q.data(), &pesos_salida[k * ancho_oculta], ancho_oculta);
+            salida[k] = 1.0f / (1.0f + exp(-escala * static_cast<float>(acc)));
+        }
+        return salida;
+    }
+
+public:
+    explicit RedNeuronalInt8(const RedNeuronal& red)
+        : entradas(red.obtener_entradas()), neuronas_oculta(red.obtener_neuronas_oculta()),
+          salidas(red.obtener_salidas()),
+          ancho_entrada(alinear_32(entradas)), ancho_oculta(alinear_32(neuronas_oculta)),
+          pesos_oculta(neuronas_oculta * ancho_entrada, 0),
+          pesos_salida(salidas * ancho_oculta, 0),
+          filas_entrada(entradas * ancho_oculta, 0),
+          sesgo_oculta(neuronas_oculta), sesgo_salida(salidas),
+          entrada_q(ancho_entrada, 0), oculta_q(ancho_oculta, 0), acumulador(ancho_oculta, 0), parcial(ancho_oculta, 0) {
+        const double* w1 = red.obtener_pesos_entrada_oculta();
+        const double* w2 = red.obtener_pesos_oculta_salida();
+        escala_oculta = escala_simetrica(w1, static_cast<size_t>(entradas) * neuronas_oculta);
+        escala_salida = escala_simetrica(w2, static_cast<size_t>(neuronas_oculta) * salidas);
+        
+        for (int i = 0; i < entradas; ++i) {
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                int8_t q = cuantizar(w1[i * neuronas_oculta + j], escala_oculta);
+                pesos_oculta[j * ancho_entrada + i] = q;
+                filas_entrada[i * ancho_oculta + j] = q;
+            }
+        }
+        for (int j = 0; j < neuronas_oculta; ++j)
+            for (int k = 0; k < salidas; ++k)
+                pesos_salida[k * ancho_oculta + j] = cuantizar(w2[j * salidas + k], escala_salida);
+        
+        for (int j = 0; j < neuronas_oculta; ++j)
+            sesgo_oculta[j] = static_cast<int32_t>(lround(red.obtener_sesgo_oculta()[j] / escala_oculta));
+        for (int k = 0; k < salidas; ++k)
+            sesgo_salida[k] = static_cast<int32_t>(lround(red.obtener_sesgo_salida()[k] * 127.0 / escala_salida));
+    }
+    
+    // Ruta densa: producto punto u8 x s8 por neurona
+    vector<double> predecir(const vector<double>& entrada) {
+        for (int i = 0; i < entradas; ++i) {
+            entrada_q[i] = entrada[i] > 0.5 ? 1 : 0;
+        }
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            oculta_q[j] = activar_oculta(sesgo_oculta[j] + producto_punto_u8_s8(
+                entrada_q.data(), &pesos_oculta[j * ancho_entrada], ancho_entrada));
+        }
+        return capa_salida();
+    }
+    
+    // Ruta de bits: suma de las filas int8 de los píxeles encendidos. Se
+    // acumula en int16 (el doble de elementos por registro que en int32) y
+    // se vuelca al acumulador int32 antes de que pueda desbordarse. La suma
+    // entera es exacta, así que coincide con la ruta densa.
+    vector<double> predecir_bits(const EntradaBits& entrada) {
+        copy(sesgo_oculta.begin(), sesgo_oculta.end(), acumulador.begin());
+        fill(parcial.begin(), parcial.end(), 0);
+        int filas_parcial = 0;
+        for (size_t w = 0; w < entrada.size(); ++w) {
+            uint64_t palabra = entrada[w];
+            while (palabra != 0) {
+                int i = static_cast<int>(w * 64) + __builtin_ctzll(palabra);
+                palabra &= palabra - 1;
+                const int8_t* fila = &filas_entrada[i * ancho_oculta];
+                for (int j = 0; j < ancho_oculta; ++j) {
+                    parcial[j] = static_cast<int16_t>(parcial[j] + fila[j]);
+                }
+                if (++filas_parcial == FILAS_POR_VOLCADO) {
+                    volcar_parcial();
+                    filas_parcial = 0;
+                }
+            }
+        }
+        volcar_parcial();
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            oculta_q[j] = activar_oculta(acumulador[j]);
+        }
+        return capa_salida();
+    }
+};
+
+#endif
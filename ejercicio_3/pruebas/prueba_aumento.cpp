@@ -0,0 +1,119 @@
+// ============================================================================
+// PRUEBA - REANUDACIÓN DEL ENTRENAMIENTO CON AUMENTO DE DATOS
+// ============================================================================
+// Entrenar con aumento, guardar el checkpoint a mitad y reanudar desde él
+// debe dar los mismos parámetros, bit a bit, que entrenar sin interrupción:
+// el checkpoint guarda la semilla y las variantes consumidas y el flujo se
+// retoma en la primera variante no entrenada.
+// ============================================================================
+
+#include "aumento.h"
+
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const string& mensaje) {
+    if (condicion) return;
+    cerr << "FALLO: " << mensaje << endl;
+    ++fallos;
+}
+
+bool mismos_parametros(const RedNeuronal& a, const RedNeuronal& b) {
+    size_t entradas = static_cast<size_t>(a.obtener_entradas());
+    size_t ocultas = static_cast<size_t>(a.obtener_neuronas_oculta());
+    size_t salidas = static_cast<size_t>(a.obtener_salidas());
+    return memcmp(a.obtener_pesos_entrada_oculta(), b.obtener_pesos_entrada_oculta(), entradas * ocultas * sizeof(double)) == 0
+        && memcmp(a.obtener_pesos_oculta_salida(), b.obtener_pesos_oculta_salida(), ocultas * salidas * sizeof(double)) == 0
+        && memcmp(a.obtener_sesgo_oculta(), b.obtener_sesgo_oculta(), ocultas * sizeof(double)) == 0
+        && memcmp(a.obtener_sesgo_salida(), b.obtener_sesgo_salida(), salidas * sizeof(double)) == 0;
+}
+
+ConfigEntrenamiento configuracion(TipoOptimizador optimizador, int epocas) {
+    ConfigEntrenamiento config;
+    config.optimizador = optimizador;
+    config.tasa_aprendizaje = optimizador == OPT_ADAM ? 0.01 : 0.1;
+    config.epocas = epocas;
+    config.mostrar_progreso = false;
+    return config;
+}
+
+void probar_reanudacion(TipoOptimizador optimizador, const vector<vector<double>>& glifos,
+                        const vector<int>& etiquetas) {
+    string caso = nombre_optimizador(optimizador);
+    string archivo = "prueba_aumento_" + caso + ".rnc";
+    ConfigAumento aumento;
+    aumento.variantes = 3;
+    aumento.semilla = 11;
+
+    RedNeuronal completa;
+    completa.configurar(configuracion(optimizador, 40));
+    entrenar_con_aumento(completa, glifos, etiquetas, aumento);
+
+    {
+        RedNeuronal primera_mitad;
+        primera_mitad.configurar(configuracion(optimizador, 20));
+        entrenar_con_aumento(primera_mitad, glifos, etiquetas, aumento);
+        comprobar(primera_mitad.guardar(archivo), caso + ": no se pudo guardar el checkpoint");
+    }
+
+    RedNeuronal reanudada;
+    comprobar(reanudada.cargar(archivo), caso + ": no se pudo cargar el checkpoint");
+    comprobar(reanudada.obtener_variantes_consumidas() == 20u * glifos.size() * 3u,
+              caso + ": variantes consumidas guardadas: " + to_string(reanudada.obtener_variantes_consumidas()));
+    ConfigEntrenamiento config = reanudada.obtener_config();
+    config.epocas = 40;
+    reanudada.configurar(config);
+    // Otra semilla en la línea de comandos no cambia el flujo reanudado
+    ConfigAumento otra_semilla = aumento;
+    otra_semilla.semilla = 99;
+    entrenar_con_aumento(reanudada, glifos, etiquetas, otra_semilla);
+    remove(archivo.c_str());
+
+    comprobar(reanudada.obtener_epoca() == completa.obtener_epoca(), caso + ": época final distinta");
+    comprobar(reanudada.obtener_variantes_consumidas() == completa.obtener_variantes_consumidas(),
+              caso + ": variantes consumidas distintas");
+    comprobar(mismos_parametros(completa, reanudada), caso + ": la red reanudada difiere de la completa");
+}
+
+} // namespace
+
+int main() {
+    // Los diez dígitos de 7x5 con un patrón al azar fijo por dígito
+    mt19937 generador(5);
+    bernoulli_distribution pixel(0.4);
+    vector<vector<double>> glifos(10, vector<double>(ENTRADAS));
+    vector<int> etiquetas;
+    for (int d = 0; d < 10; ++d) {
+        for (double& x : glifos[d]) x = pixel(generador) ? 1.0 : 0.0;
+        etiquetas.push_back(d);
+    }
+
+    for (TipoOptimizador optimizador : {OPT_SGD, OPT_MOMENTUM, OPT_ADAM}) {
+        probar_reanudacion(optimizador, glifos, etiquetas);
+    }
+
+    // Valores fuera de rango
+    ConfigAumento config;
+    config.variantes = 0;
+    comprobar(!validar_config_aumento(config), "se aceptó --variantes 0");
+    config = ConfigAumento();
+    config.prob_inversion = 1.5;
+    comprobar(!validar_config_aumento(config), "se aceptó --prob-inversion 1.5");
+    config = ConfigAumento();
+    config.prob_desplazamiento = -0.1;
+    comprobar(!validar_config_aumento(config), "se aceptó --prob-desplazamiento -0.1");
+    comprobar(validar_config_aumento(ConfigAumento()), "se rechazó la configuración por defecto");
+
+    if (fallos) {
+        cerr << fallos << " comprobación(es) fallida(s)" << endl;
+        return 1;
+    }
+    cout << "Reanudación con aumento: idéntica" << endl;
+    return 0;
+}
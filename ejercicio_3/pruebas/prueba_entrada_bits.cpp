@@ -0,0 +1,94 @@
+// ============================================================================
+// PRUEBA - RUTA BINARIA FRENTE A RUTA DENSA
+// ============================================================================
+// Con entradas 0/1, entrenar por forward_bits/backward_bits debe dar los
+// mismos parámetros, bit a bit, que entrenar por forward/backward con la
+// entrada desempaquetada, con los tres optimizadores y con las opciones de
+// compilación por defecto (-march=native incluido). Se comparan también las
+// salidas de forward y forward_bits sobre la red entrenada.
+// ============================================================================
+
+#include "red_neuronal.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const string& mensaje) {
+    if (condicion) return;
+    cerr << "FALLO: " << mensaje << endl;
+    ++fallos;
+}
+
+bool mismos_bits(const double* a, const double* b, size_t n) {
+    return memcmp(a, b, n * sizeof(double)) == 0;
+}
+
+void probar(int entradas, int ocultas, double densidad, TipoOptimizador optimizador, double tasa) {
+    string caso = to_string(entradas) + " entradas, " + to_string(ocultas) + " ocultas, " + nombre_optimizador(optimizador);
+
+    // Patrones 0/1 al azar con la densidad indicada y objetivos de 0/1
+    mt19937 generador(entradas * 31 + ocultas);
+    bernoulli_distribution pixel(densidad);
+    bernoulli_distribution clase(0.5);
+    vector<vector<double>> datos(20, vector<double>(entradas));
+    vector<vector<double>> objetivos(datos.size(), vector<double>(SALIDAS));
+    vector<EntradaBits> datos_bits;
+    for (size_t p = 0; p < datos.size(); ++p) {
+        for (double& x : datos[p]) x = pixel(generador) ? 1.0 : 0.0;
+        for (double& y : objetivos[p]) y = clase(generador) ? 1.0 : 0.0;
+        datos_bits.push_back(empaquetar_entrada(datos[p]));
+    }
+
+    ConfigEntrenamiento config;
+    config.optimizador = optimizador;
+    config.tasa_aprendizaje = tasa;
+    config.calendario = TASA_COSENO;
+    config.epocas = 30;
+    config.mostrar_progreso = false;
+
+    RedNeuronal densa(entradas, ocultas, SALIDAS, 7);
+    RedNeuronal binaria(entradas, ocultas, SALIDAS, 7);
+    densa.configurar(config);
+    binaria.configurar(config);
+    ResultadoEntrenamiento r_densa = densa.entrenar_densa(datos, objetivos);
+    ResultadoEntrenamiento r_binaria = binaria.entrenar_bits(datos_bits, objetivos);
+
+    comprobar(r_densa.error_final == r_binaria.error_final, caso + ": error final distinto");
+    comprobar(mismos_bits(densa.obtener_pesos_entrada_oculta(), binaria.obtener_pesos_entrada_oculta(),
+                          static_cast<size_t>(entradas) * ocultas), caso + ": pesos entrada-oculta distintos");
+    comprobar(mismos_bits(densa.obtener_pesos_oculta_salida(), binaria.obtener_pesos_oculta_salida(),
+                          static_cast<size_t>(ocultas) * SALIDAS), caso + ": pesos oculta-salida distintos");
+    comprobar(mismos_bits(densa.obtener_sesgo_oculta(), binaria.obtener_sesgo_oculta(), ocultas),
+              caso + ": sesgos ocultos distintos");
+    comprobar(mismos_bits(densa.obtener_sesgo_salida(), binaria.obtener_sesgo_salida(), SALIDAS),
+              caso + ": sesgos de salida distintos");
+
+    for (size_t p = 0; p < datos.size(); ++p) {
+        vector<double> salida = densa.forward(datos[p]);
+        vector<double> salida_bits = densa.forward_bits(datos_bits[p]);
+        comprobar(mismos_bits(salida.data(), salida_bits.data(), salida.size()),
+                  caso + ": forward y forward_bits difieren en el patrón " + to_string(p));
+    }
+}
+
+} // namespace
+
+int main() {
+    for (TipoOptimizador optimizador : {OPT_SGD, OPT_MOMENTUM, OPT_ADAM}) {
+        double tasa = optimizador == OPT_ADAM ? 0.01 : 0.1;
+        probar(ENTRADAS, NEURONAS_OCULTA, 0.4, optimizador, tasa);   // Glifos de 7x5
+        probar(28 * 28, 64, 0.1, optimizador, tasa);                  // Imágenes de 28x28
+    }
+
+    if (fallos) {
+        cerr << fallos << " comprobación(es) fallida(s)" << endl;
+        return 1;
+    }
+    cout << "Ruta binaria y ruta densa: idénticas" << endl;
+    return 0;
+}
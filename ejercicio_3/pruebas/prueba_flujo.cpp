@@ -0,0 +1,85 @@
+// ============================================================================
+// PRUEBA - ENTRENAMIENTO EN FLUJO CON ERRORES DE LECTURA
+// ============================================================================
+// Si el archivo no se puede abrir o termina antes de los glifos que anuncia
+// su cabecera, entrenar_desde_archivo debe fallar sin contar la época, sin
+// escribir el checkpoint y sin dar el modelo por entrenado. Un archivo
+// completo debe entrenar todas las épocas.
+// ============================================================================
+
+#include "datos.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const string& mensaje) {
+    if (condicion) return;
+    cerr << "FALLO: " << mensaje << endl;
+    ++fallos;
+}
+
+// Binario .glb con 'cantidad' glifos en la cabecera y 'registros' escritos
+void escribir_binario(const string& nombre, uint64_t cantidad, uint64_t registros) {
+    CabeceraGlifos cabecera = {};
+    copy(begin(MAGIA_GLIFOS), end(MAGIA_GLIFOS), cabecera.magia);
+    cabecera.filas = FILAS_DIGITO;
+    cabecera.columnas = COLS_DIGITO;
+    cabecera.cantidad = cantidad;
+    ofstream salida(nombre, ios::binary | ios::trunc);
+    salida.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    vector<char> registro(1 + (ENTRADAS + 7) / 8);
+    for (uint64_t i = 0; i < registros; ++i) {
+        registro[0] = static_cast<char>(i % 10);
+        for (size_t b = 1; b < registro.size(); ++b) registro[b] = static_cast<char>(i * 37 + b * 11);
+        salida.write(registro.data(), static_cast<streamsize>(registro.size()));
+    }
+}
+
+bool existe(const string& nombre) {
+    return ifstream(nombre).is_open();
+}
+
+void probar(const string& caso, const string& entrada, bool debe_entrenar) {
+    const string checkpoint = "prueba_flujo.rnc";
+    remove(checkpoint.c_str());
+
+    RedNeuronal red;
+    ConfigEntrenamiento config;
+    config.epocas = 3;
+    config.mostrar_progreso = false;
+    red.configurar(config);
+    bool entrenado = entrenar_desde_archivo(red, entrada, checkpoint, true);
+
+    comprobar(entrenado == debe_entrenar, caso + ": resultado de entrenar_desde_archivo");
+    comprobar(red.entrenamiento_finalizado() == debe_entrenar, caso + ": estado finalizado");
+    comprobar(red.obtener_epoca() == (debe_entrenar ? 3 : 0), caso + ": época " + to_string(red.obtener_epoca()));
+    if (!debe_entrenar) comprobar(!existe(checkpoint), caso + ": se escribió el checkpoint");
+    remove(checkpoint.c_str());
+}
+
+} // namespace
+
+int main() {
+    escribir_binario("prueba_flujo_completo.glb", 50, 50);
+    escribir_binario("prueba_flujo_truncado.glb", 50, 43);
+
+    probar("archivo completo", "prueba_flujo_completo.glb", true);
+    probar("archivo truncado", "prueba_flujo_truncado.glb", false);
+    probar("archivo inexistente", "prueba_flujo_no_existe.glb", false);
+
+    remove("prueba_flujo_completo.glb");
+    remove("prueba_flujo_truncado.glb");
+
+    if (fallos) {
+        cerr << fallos << " comprobación(es) fallida(s)" << endl;
+        return 1;
+    }
+    cout << "Entrenamiento en flujo: errores de lectura detectados" << endl;
+    return 0;
+}
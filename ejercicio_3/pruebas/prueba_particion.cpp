@@ -0,0 +1,114 @@
+// ============================================================================
+// PRUEBA - PARTICIÓN EN PLIEGUES DE LA VALIDACIÓN CRUZADA
+// ============================================================================
+// Con dígitos de tamaños desiguales (incluidos dígitos con menos glifos que
+// pliegues), cada glifo debe validarse en exactamente un pliegue, el
+// entrenamiento de cada pliegue debe ser el complemento de su validación y
+// los tamaños de validación deben diferir en a lo sumo uno, en total y
+// dentro de cada dígito.
+// ============================================================================
+
+#include "validacion.h"
+
+using namespace std;
+
+namespace {
+
+int fallos = 0;
+
+void comprobar(bool condicion, const string& mensaje) {
+    if (condicion) return;
+    cerr << "FALLO: " << mensaje << endl;
+    ++fallos;
+}
+
+DatosEtiquetados crear_datos(const vector<int>& glifos_por_digito) {
+    DatosEtiquetados datos;
+    for (int d = 0; d < static_cast<int>(glifos_por_digito.size()); ++d) {
+        for (int i = 0; i < glifos_por_digito[d]; ++i) {
+            datos.glifos.push_back(vector<double>(ENTRADAS, 0.0));
+            datos.etiquetas.push_back(d);
+        }
+    }
+    return datos;
+}
+
+void probar(const vector<int>& glifos_por_digito, int pliegues, unsigned semilla) {
+    DatosEtiquetados datos = crear_datos(glifos_por_digito);
+    size_t n = datos.glifos.size();
+    string caso = to_string(n) + " glifos, " + to_string(pliegues) + " pliegues, semilla " + to_string(semilla);
+    Particion particion = particionar(datos, pliegues, semilla);
+
+    comprobar(particion.validacion.size() == static_cast<size_t>(pliegues)
+              && particion.entrenamiento.size() == static_cast<size_t>(pliegues), caso + ": número de pliegues");
+    if (fallos) return;
+
+    vector<int> veces_validado(n, 0);
+    size_t minimo = n, maximo = 0;
+    for (int f = 0; f < pliegues; ++f) {
+        const vector<size_t>& validacion = particion.validacion[f];
+        const vector<size_t>& entrenamiento = particion.entrenamiento[f];
+        minimo = min(minimo, validacion.size());
+        maximo = max(maximo, validacion.size());
+        comprobar(validacion.size() + entrenamiento.size() == n, caso + ": pliegue " + to_string(f) + " no cubre todos los glifos");
+
+        vector<bool> en_validacion(n, false);
+        for (size_t i : validacion) {
+            en_validacion[i] = true;
+            ++veces_validado[i];
+        }
+        for (size_t i : entrenamiento) {
+            comprobar(!en_validacion[i], caso + ": glifo " + to_string(i) + " en entrenamiento y validación");
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        comprobar(veces_validado[i] == 1, caso + ": glifo " + to_string(i) + " validado "
+                  + to_string(veces_validado[i]) + " veces");
+    }
+    comprobar(minimo >= 1, caso + ": pliegue de validación vacío");
+    comprobar(maximo - minimo <= 1, caso + ": tamaños de validación entre " + to_string(minimo)
+              + " y " + to_string(maximo));
+
+    for (int d = 0; d < static_cast<int>(glifos_por_digito.size()); ++d) {
+        int menor = numeric_limits<int>::max(), mayor = 0;
+        for (int f = 0; f < pliegues; ++f) {
+            int cuenta = 0;
+            for (size_t i : particion.validacion[f]) cuenta += datos.etiquetas[i] == d ? 1 : 0;
+            menor = min(menor, cuenta);
+            mayor = max(mayor, cuenta);
+        }
+        comprobar(mayor - menor <= 1, caso + ": dígito " + to_string(d) + " entre " + to_string(menor)
+                  + " y " + to_string(mayor) + " por pliegue");
+    }
+}
+
+} // namespace
+
+int main() {
+    // Un glifo por dígito: con un contador por dígito los diez irían al
+    // primer pliegue
+    vector<int> uno_por_digito(10, 1);
+    vector<int> desiguales = {1, 2, 3, 5, 8, 13, 21, 4, 7, 11};
+    vector<int> iguales(10, 12);
+
+    for (int pliegues : {2, 3, 5, 7, 10}) {
+        for (unsigned semilla : {1u, 2025u}) {
+            probar(uno_por_digito, pliegues, semilla);
+            probar(desiguales, pliegues, semilla);
+            probar(iguales, pliegues, semilla);
+        }
+    }
+
+    // Misma semilla, misma partición
+    DatosEtiquetados datos = crear_datos(desiguales);
+    Particion a = particionar(datos, 5, 7);
+    Particion b = particionar(datos, 5, 7);
+    comprobar(a.validacion == b.validacion && a.entrenamiento == b.entrenamiento, "la partición no es reproducible");
+
+    if (fallos) {
+        cerr << fallos << " comprobación(es) fallida(s)" << endl;
+        return 1;
+    }
+    cout << "Partición en pliegues: correcta" << endl;
+    return 0;
+}
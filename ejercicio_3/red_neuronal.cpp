@@ -0,0 +1,345 @@
+#include "red_neuronal.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// ==================== ARCHIVO MAPEADO EN MEMORIA ====================
+bool ArchivoMapeado::abrir(const string& nombre_archivo) {
+    cerrar();
+#ifdef _WIN32
+    HANDLE manejador = CreateFileA(nombre_archivo.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (manejador == INVALID_HANDLE_VALUE) return false;
+    archivo = manejador;
+    LARGE_INTEGER bytes;
+    if (!GetFileSizeEx(manejador, &bytes) || bytes.QuadPart == 0) { cerrar(); return false; }
+    tamano = static_cast<size_t>(bytes.QuadPart);
+    mapeo = CreateFileMappingA(manejador, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapeo == nullptr) { cerrar(); return false; }
+    datos = MapViewOfFile(mapeo, FILE_MAP_COPY, 0, 0, 0);
+    if (datos == nullptr) { cerrar(); return false; }
+#else
+    int fd = open(nombre_archivo.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) { ::close(fd); return false; }
+    tamano = static_cast<size_t>(info.st_size);
+    void* region = mmap(nullptr, tamano, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // El mapeo sigue siendo válido tras cerrar el descriptor
+    if (region == MAP_FAILED) { tamano = 0; return false; }
+    datos = region;
+#endif
+    return true;
+}
+
+void ArchivoMapeado::cerrar() {
+#ifdef _WIN32
+    if (datos != nullptr) UnmapViewOfFile(datos);
+    if (mapeo != nullptr) CloseHandle(mapeo);
+    if (archivo != nullptr) CloseHandle(archivo);
+    mapeo = nullptr;
+    archivo = nullptr;
+#else
+    if (datos != nullptr) munmap(datos, tamano);
+#endif
+    datos = nullptr;
+    tamano = 0;
+}
+
+// ==================== OPTIMIZADORES Y CALENDARIOS ====================
+string nombre_optimizador(TipoOptimizador tipo) {
+    switch (tipo) {
+        case OPT_SGD: return "SGD";
+        case OPT_MOMENTUM: return "Momentum";
+        case OPT_ADAM: return "Adam";
+        default: return "Desconocido";
+    }
+}
+
+string nombre_calendario(TipoCalendario tipo) {
+    switch (tipo) {
+        case TASA_CONSTANTE: return "constante";
+        case TASA_ESCALONADA: return "escalonada";
+        case TASA_EXPONENCIAL: return "exponencial";
+        case TASA_COSENO: return "coseno";
+        default: return "desconocido";
+    }
+}
+
+bool interpretar_optimizador(const string& texto, TipoOptimizador& tipo) {
+    if (texto == "sgd") tipo = OPT_SGD;
+    else if (texto == "momentum") tipo = OPT_MOMENTUM;
+    else if (texto == "adam") tipo = OPT_ADAM;
+    else {
+        cerr << "Error: Optimizador desconocido: " << texto << " (sgd, momentum o adam)" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool interpretar_calendario(const string& texto, TipoCalendario& tipo) {
+    if (texto == "constante" || texto == "constant") tipo = TASA_CONSTANTE;
+    else if (texto == "escalonada" || texto == "step") tipo = TASA_ESCALONADA;
+    else if (texto == "exponencial" || texto == "exponential") tipo = TASA_EXPONENCIAL;
+    else if (texto == "coseno" || texto == "cosine") tipo = TASA_COSENO;
+    else {
+        cerr << "Error: Calendario desconocido: " << texto
+             << " (constante, escalonada, exponencial o coseno)" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool validar_config(const ConfigEntrenamiento& config) {
+    const char* problema = nullptr;
+    if (!(config.tasa_aprendizaje > 0.0)) problema = "la tasa de aprendizaje debe ser > 0";
+    else if (config.epocas < 1) problema = "las épocas deben ser >= 1";
+    else if (config.paso_calendario < 1) problema = "el paso del calendario debe ser >= 1";
+    else if (!(config.factor_calendario > 0.0)) problema = "el factor del calendario debe ser > 0";
+    else if (!(config.momento >= 0.0 && config.momento < 1.0)) problema = "el momento debe estar en [0, 1)";
+    else if (!(config.beta1 >= 0.0 && config.beta1 < 1.0)) problema = "beta1 debe estar en [0, 1)";
+    else if (!(config.beta2 >= 0.0 && config.beta2 < 1.0)) problema = "beta2 debe estar en [0, 1)";
+    else if (!(config.epsilon > 0.0)) problema = "epsilon debe ser > 0";
+    else if (config.paciencia < 0) problema = "la paciencia debe ser >= 0";
+    else if (!(config.mejora_minima >= 0.0)) problema = "la mejora mínima debe ser >= 0";
+    
+    if (problema != nullptr) {
+        cerr << "Error: Configuración de entrenamiento inválida: " << problema << endl;
+        return false;
+    }
+    return true;
+}
+
+double tasa_segun_calendario(const ConfigEntrenamiento& config, int epoca) {
+    switch (config.calendario) {
+        case TASA_ESCALONADA:
+            return config.tasa_aprendizaje * pow(config.factor_calendario, epoca / config.paso_calendario);
+        case TASA_EXPONENCIAL:
+            return config.tasa_aprendizaje
+                 * pow(config.factor_calendario, static_cast<double>(epoca) / config.paso_calendario);
+        case TASA_COSENO:
+            return config.tasa_aprendizaje * 0.5 * (1.0 + cos(M_PI * epoca / config.epocas));
+        case TASA_CONSTANTE:
+        default:
+            return config.tasa_aprendizaje;
+    }
+}
+
+// ==================== ENTRADAS EMPAQUETADAS EN BITS ====================
+EntradaBits empaquetar_entrada(const vector<double>& entrada) {
+    EntradaBits bits((entrada.size() + 63) / 64, 0);
+    for (size_t i = 0; i < entrada.size(); ++i) {
+        if (entrada[i] > 0.5) {
+            bits[i / 64] |= (uint64_t(1) << (i % 64));
+        }
+    }
+    return bits;
+}
+
+bool es_entrada_binaria(const vector<vector<double>>& datos) {
+    for (const vector<double>& entrada : datos) {
+        for (double x : entrada) {
+            if (x != 0.0 && x != 1.0) return false;
+        }
+    }
+    return true;
+}
+
+// ==================== PERSISTENCIA ====================
+bool RedNeuronal::guardar(const string& nombre_archivo) {
+    // Si los pesos vienen de un mapeo, reescribir el mismo archivo mientras
+    // está mapeado invalidaría las páginas aún no copiadas
+    materializar();
+    
+    ostringstream estado_rng;
+    estado_rng << generador;
+    string texto_rng = estado_rng.str();
+    
+    CabeceraCheckpoint cabecera = {};
+    copy(begin(MAGIA_CHECKPOINT), end(MAGIA_CHECKPOINT), cabecera.magia);
+    cabecera.version = VERSION_CHECKPOINT;
+    cabecera.tipo_dato = TIPO_DATO_F64;
+    cabecera.entradas = static_cast<uint32_t>(entradas);
+    cabecera.neuronas_oculta = static_cast<uint32_t>(neuronas_oculta);
+    cabecera.salidas = static_cast<uint32_t>(salidas);
+    cabecera.alineacion = static_cast<uint32_t>(ALINEACION_CHECKPOINT);
+    cabecera.epoca = static_cast<uint64_t>(epoca_actual);
+    cabecera.tasa_aprendizaje = config.tasa_aprendizaje;
+    cabecera.desplazamiento_parametros = alinear_desplazamiento(sizeof(CabeceraCheckpoint));
+    cabecera.num_parametros = num_parametros();
+    cabecera.desplazamiento_optimizador = alinear_desplazamiento(
+        cabecera.desplazamiento_parametros + cabecera.num_parametros * sizeof(double));
+    cabecera.num_optimizador = estado_1.size() + estado_2.size();
+    cabecera.desplazamiento_rng = alinear_desplazamiento(
+        cabecera.desplazamiento_optimizador + cabecera.num_optimizador * sizeof(double));
+    cabecera.bytes_rng = texto_rng.size();
+    cabecera.tipo_optimizador = static_cast<uint32_t>(config.optimizador);
+    cabecera.finalizado = finalizado ? 1u : 0u;
+    cabecera.pasos_optimizador = pasos_optimizador;
+    cabecera.calendario = static_cast<uint32_t>(config.calendario);
+    cabecera.paso_calendario = config.paso_calendario;
+    cabecera.factor_calendario = config.factor_calendario;
+    cabecera.momento = config.momento;
+    cabecera.beta1 = config.beta1;
+    cabecera.beta2 = config.beta2;
+    cabecera.epsilon = config.epsilon;
+    cabecera.epocas = config.epocas;
+    cabecera.paciencia = config.paciencia;
+    cabecera.error_objetivo = config.error_objetivo;
+    cabecera.mejora_minima = config.mejora_minima;
+    cabecera.mejor_error = mejor_error;
+    cabecera.epocas_sin_mejora = epocas_sin_mejora;
+    cabecera.semilla_aumento = semilla_aumento;
+    cabecera.variantes_consumidas = variantes_consumidas;
+    
+    ofstream archivo(nombre_archivo, ios::binary | ios::trunc);
+    if (!archivo.is_open()) {
+        cerr << "Error: No se pudo crear el checkpoint " << nombre_archivo << endl;
+        return false;
+    }
+    
+    auto rellenar_hasta = [&archivo](uint64_t desplazamiento) {
+        static const char ceros[ALINEACION_CHECKPOINT] = {};
+        uint64_t actual = static_cast<uint64_t>(archivo.tellp());
+        archivo.write(ceros, static_cast<streamsize>(desplazamiento - actual));
+    };
+    
+    archivo.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+    rellenar_hasta(cabecera.desplazamiento_parametros);
+    archivo.write(reinterpret_cast<const char*>(parametros.data()),
+                  static_cast<streamsize>(cabecera.num_parametros * sizeof(double)));
+    rellenar_hasta(cabecera.desplazamiento_optimizador);
+    archivo.write(reinterpret_cast<const char*>(estado_1.data()),
+                  static_cast<streamsize>(estado_1.size() * sizeof(double)));
+    archivo.write(reinterpret_cast<const char*>(estado_2.data()),
+                  static_cast<streamsize>(estado_2.size() * sizeof(double)));
+    rellenar_hasta(cabecera.desplazamiento_rng);
+    archivo.write(texto_rng.data(), static_cast<streamsize>(texto_rng.size()));
+    
+    if (!archivo) {
+        cerr << "Error: Falló la escritura del checkpoint " << nombre_archivo << endl;
+        return false;
+    }
+    return true;
+}
+
+bool RedNeuronal::cargar(const string& nombre_archivo) {
+    ArchivoMapeado mapeo;
+    if (!mapeo.abrir(nombre_archivo)) {
+        return false;
+    }
+    
+    if (mapeo.obtener_tamano() < sizeof(CabeceraCheckpoint)) {
+        cerr << "Error: Checkpoint truncado en " << nombre_archivo << endl;
+        return false;
+    }
+    CabeceraCheckpoint cabecera;
+    memcpy(&cabecera, mapeo.obtener_datos(), sizeof(cabecera));
+    
+    // Configuración guardada (v3); en versiones anteriores se conserva la actual
+    ConfigEntrenamiento config_cargada = config;
+    if (cabecera.version >= 3) {
+        config_cargada.calendario = static_cast<TipoCalendario>(cabecera.calendario);
+        config_cargada.paso_calendario = cabecera.paso_calendario;
+        config_cargada.factor_calendario = cabecera.factor_calendario;
+        config_cargada.momento = cabecera.momento;
+        config_cargada.beta1 = cabecera.beta1;
+        config_cargada.beta2 = cabecera.beta2;
+        config_cargada.epsilon = cabecera.epsilon;
+        config_cargada.epocas = cabecera.epocas;
+        config_cargada.paciencia = cabecera.paciencia;
+        config_cargada.error_objetivo = cabecera.error_objetivo;
+        config_cargada.mejora_minima = cabecera.mejora_minima;
+    }
+    config_cargada.tasa_aprendizaje = cabecera.tasa_aprendizaje;
+    
+    if (!equal(begin(MAGIA_CHECKPOINT), end(MAGIA_CHECKPOINT), cabecera.magia)) {
+        cerr << "Error: " << nombre_archivo << " no es un checkpoint de RedNeuronal\n";
+        return false;
+    }
+    if (cabecera.version < 1 || cabecera.version > VERSION_CHECKPOINT || cabecera.tipo_dato != TIPO_DATO_F64) {
+        cerr << "Error: Versión o tipo de dato no soportado en " << nombre_archivo << endl;
+        return false;
+    }
+    
+    uint64_t esperado = static_cast<uint64_t>(cabecera.entradas) * cabecera.neuronas_oculta
+                      + static_cast<uint64_t>(cabecera.neuronas_oculta) * cabecera.salidas
+                      + cabecera.neuronas_oculta + cabecera.salidas;
+    uint64_t fin_parametros = cabecera.desplazamiento_parametros + cabecera.num_parametros * sizeof(double);
+    uint64_t fin_optimizador = cabecera.desplazamiento_optimizador + cabecera.num_optimizador * sizeof(double);
+    uint64_t fin_rng = cabecera.desplazamiento_rng + cabecera.bytes_rng;
+    uint64_t esperado_optimizador = cabecera.tipo_optimizador == OPT_ADAM ? 2 * esperado
+                                  : cabecera.tipo_optimizador == OPT_MOMENTUM ? esperado : 0;
+    if (cabecera.num_parametros != esperado
+        || cabecera.tipo_optimizador > OPT_ADAM
+        || (cabecera.version >= 3 && cabecera.calendario > TASA_COSENO)
+        || cabecera.num_optimizador != esperado_optimizador
+        || fin_optimizador > mapeo.obtener_tamano()
+        || cabecera.desplazamiento_parametros % ALINEACION_CHECKPOINT != 0
+        || fin_parametros > mapeo.obtener_tamano() || fin_rng > mapeo.obtener_tamano()) {
+        cerr << "Error: Checkpoint inconsistente en " << nombre_archivo << endl;
+        return false;
+    }
+    
+    istringstream estado_rng(string(mapeo.obtener_datos() + cabecera.desplazamiento_rng,
+                                    cabecera.bytes_rng));
+    mt19937 generador_cargado;
+    if (!(estado_rng >> generador_cargado)) {
+        cerr << "Error: Estado del generador inválido en " << nombre_archivo << endl;
+        return false;
+    }
+    config_cargada.optimizador = static_cast<TipoOptimizador>(cabecera.tipo_optimizador);
+    if (!validar_config(config_cargada)) {
+        cerr << "Error: Checkpoint inconsistente en " << nombre_archivo << endl;
+        return false;
+    }
+    
+    entradas = static_cast<int>(cabecera.entradas);
+    neuronas_oculta = static_cast<int>(cabecera.neuronas_oculta);
+    salidas = static_cast<int>(cabecera.salidas);
+    activacion_entrada.assign(entradas, 0.0);
+    activacion_oculta.assign(neuronas_oculta, 0.0);
+    activacion_salida.assign(salidas, 0.0);
+    error_salida.assign(salidas, 0.0);
+    error_oculta.assign(neuronas_oculta, 0.0);
+    epoca_actual = static_cast<int>(cabecera.epoca);
+    finalizado = cabecera.finalizado != 0;
+    config = config_cargada;
+    if (cabecera.version >= 3) {
+        mejor_error = cabecera.mejor_error;
+        epocas_sin_mejora = cabecera.epocas_sin_mejora;
+    } else {
+        mejor_error = numeric_limits<double>::infinity();
+        epocas_sin_mejora = 0;
+    }
+    semilla_aumento = cabecera.version >= 4 ? cabecera.semilla_aumento : 0;
+    variantes_consumidas = cabecera.version >= 4 ? cabecera.variantes_consumidas : 0;
+    generador = generador_cargado;
+    
+    // El estado del optimizador es pequeño y se modifica en cada paso: se copia
+    const double* optimizador = reinterpret_cast<const double*>(
+        mapeo.obtener_datos() + cabecera.desplazamiento_optimizador);
+    size_t n = static_cast<size_t>(esperado);
+    estado_1.assign(optimizador, optimizador + (config.optimizador == OPT_SGD ? 0 : n));
+    estado_2.assign(optimizador + estado_1.size(),
+                    optimizador + estado_1.size() + (config.optimizador == OPT_ADAM ? n : 0));
+    pasos_optimizador = cabecera.pasos_optimizador;
+    
+    modelo_mapeado = move(mapeo);
+    parametros.clear();
+    parametros.shrink_to_fit();
+    asignar_vistas(reinterpret_cast<double*>(
+        modelo_mapeado.obtener_datos() + cabecera.desplazamiento_parametros));
+    return true;
+}
@@ -0,0 +1,743 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - BIBLIOTECA
+// ============================================================================
+// Red feedforward de una capa oculta con retropropagación, optimizadores
+// (SGD, Momentum, Adam) y checkpoints binarios cargados con mmap.
+// ============================================================================
+
+#ifndef RED_NEURONAL_H
+#define RED_NEURONAL_H
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <string>
+#include <iomanip>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "instrumentacion.h"
+
+using namespace std;
+
+// ==================== CONSTANTES ====================
+const int FILAS_DIGITO = 7;      // Altura de cada dígito (7 filas)
+const int COLS_DIGITO = 5;       // Ancho de cada dígito (5 columnas)
+const int ENTRADAS = 35;         // Total de píxeles (7x5 = 35)
+const int NEURONAS_OCULTA = 20;  // Neuronas en la capa oculta
+const int SALIDAS = 4;           // 4 categorías de clasificación
+const double TASA_APRENDIZAJE = 0.1;
+const int EPOCAS = 5000;         // Número de iteraciones de entrenamiento
+
+// ==================== FUNCIÓN DE ACTIVACIÓN SIGMOIDE ====================
+// Squash de valores al rango (0, 1)
+inline double sigmoide(double x) {
+    return 1.0 / (1.0 + exp(-x));
+}
+
+// Derivada de la sigmoide (para backpropagation)
+inline double derivada_sigmoide(double x) {
+    return x * (1.0 - x);
+}
+
+// ==================== ARCHIVO MAPEADO EN MEMORIA ====================
+// Mapea un archivo completo en modo copia-en-escritura: las páginas se leen
+// directamente del archivo y solo se copian si el proceso las modifica
+// (por ejemplo, al reanudar el entrenamiento sobre un modelo cargado).
+class ArchivoMapeado {
+private:
+    void* datos;
+    size_t tamano;
+#ifdef _WIN32
+    void* archivo;   // HANDLE (windows.h solo se incluye en red_neuronal.cpp)
+    void* mapeo;     // HANDLE
+#endif
+
+public:
+    ArchivoMapeado() : datos(nullptr), tamano(0)
+#ifdef _WIN32
+        , archivo(nullptr), mapeo(nullptr)
+#endif
+    {}
+    
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+    
+    ArchivoMapeado(ArchivoMapeado&& otro) noexcept : ArchivoMapeado() { swap(otro); }
+    ArchivoMapeado& operator=(ArchivoMapeado&& otro) noexcept {
+        if (this != &otro) { cerrar(); swap(otro); }
+        return *this;
+    }
+    
+    ~ArchivoMapeado() { cerrar(); }
+    
+    void swap(ArchivoMapeado& otro) noexcept {
+        std::swap(datos, otro.datos);
+        std::swap(tamano, otro.tamano);
+#ifdef _WIN32
+        std::swap(archivo, otro.archivo);
+        std::swap(mapeo, otro.mapeo);
+#endif
+    }
+    
+    bool abrir(const string& nombre_archivo);
+    void cerrar();
+    
+    char* obtener_datos() const { return static_cast<char*>(datos); }
+    size_t obtener_tamano() const { return tamano; }
+    bool esta_abierto() const { return datos != nullptr; }
+};
+
+// ==================== FORMATO DE CHECKPOINT ====================
+// Archivo binario versionado (little-endian, tipos nativos):
+//   [CabeceraCheckpoint]
+//   [parámetros]   pesos_entrada_oculta | pesos_oculta_salida | sesgo_oculta | sesgo_salida
+//   [optimizador]  estado del optimizador (doubles): velocidad de Momentum,
+//                  o primer y segundo momento de Adam, uno por parámetro
+//   [rng]          estado de mt19937 en texto
+// La cabecera guarda además la configuración del entrenamiento (calendario,
+// hiperparámetros del optimizador y parada temprana) y la posición en el
+// flujo del aumento de datos, para reanudarlo igual.
+// Cada bloque comienza en un desplazamiento múltiplo de ALINEACION_CHECKPOINT
+// para poder usarse en el lugar tras mapear el archivo.
+const char MAGIA_CHECKPOINT[8] = {'R', 'N', 'D', 'C', 'K', 'P', 'T', '\0'};
+const uint32_t VERSION_CHECKPOINT = 4;   // v2: optimizador, pasos y estado finalizado
+                                         // v3: calendario, betas y estado de la paciencia
+                                         // v4: semilla y variantes consumidas del aumento
+const uint32_t TIPO_DATO_F64 = 1;
+const uint64_t ALINEACION_CHECKPOINT = 64;
+
+struct CabeceraCheckpoint {
+    char magia[8];
+    uint32_t version;
+    uint32_t tipo_dato;
+    uint32_t entradas;
+    uint32_t neuronas_oculta;
+    uint32_t salidas;
+    uint32_t alineacion;
+    uint64_t epoca;                  // Épocas de entrenamiento completadas
+    double tasa_aprendizaje;
+    uint64_t desplazamiento_parametros;
+    uint64_t num_parametros;
+    uint64_t desplazamiento_optimizador;
+    uint64_t num_optimizador;
+    uint64_t desplazamiento_rng;
+    uint64_t bytes_rng;
+    // v2 (en la v1 estos campos caen en el relleno a cero)
+    uint32_t tipo_optimizador;
+    uint32_t finalizado;             // El entrenamiento terminó (parada temprana incluida)
+    uint64_t pasos_optimizador;
+    // v3 (en v1 y v2 se conserva la configuración actual de la red)
+    uint32_t calendario;
+    int32_t paso_calendario;
+    double factor_calendario;
+    double momento;
+    double beta1;
+    double beta2;
+    double epsilon;
+    int32_t epocas;
+    int32_t paciencia;
+    double error_objetivo;
+    double mejora_minima;
+    double mejor_error;              // Mejor error por época visto por la paciencia
+    int32_t epocas_sin_mejora;
+    // v4 (en versiones anteriores, sin aumento: el flujo empieza de cero)
+    uint32_t semilla_aumento;
+    uint64_t variantes_consumidas;   // Variantes del aumento ya entrenadas
+};
+
+inline uint64_t alinear_desplazamiento(uint64_t desplazamiento) {
+    return (desplazamiento + ALINEACION_CHECKPOINT - 1) & ~(ALINEACION_CHECKPOINT - 1);
+}
+
+// ==================== ENTRADAS EMPAQUETADAS EN BITS ====================
+// Los píxeles de digitos.txt son 0 o 1: se guardan como 1 bit por píxel
+// en palabras de 64 bits (bit i de la palabra i/64 = píxel i)
+using EntradaBits = vector<uint64_t>;
+
+EntradaBits empaquetar_entrada(const vector<double>& entrada);
+
+// Todos los valores son exactamente 0 o 1 (el empaquetado no pierde nada)
+bool es_entrada_binaria(const vector<vector<double>>& datos);
+
+// ==================== OPTIMIZADORES Y CALENDARIOS ====================
+enum TipoOptimizador { OPT_SGD, OPT_MOMENTUM, OPT_ADAM };
+
+// Calendario de la tasa de aprendizaje en función de la época
+enum TipoCalendario { TASA_CONSTANTE, TASA_ESCALONADA, TASA_EXPONENCIAL, TASA_COSENO };
+
+struct ConfigEntrenamiento {
+    TipoOptimizador optimizador = OPT_SGD;
+    double tasa_aprendizaje = TASA_APRENDIZAJE;
+    double momento = 0.9;        // Momentum
+    double beta1 = 0.9;          // Adam: media de los gradientes
+    double beta2 = 0.999;        // Adam: media de los cuadrados
+    double epsilon = 1e-8;       // Adam: estabilidad numérica
+    
+    TipoCalendario calendario = TASA_CONSTANTE;
+    int paso_calendario = 1000;  // Escalonada/exponencial: épocas por reducción
+    double factor_calendario = 0.5;
+    
+    int epocas = EPOCAS;         // Máximo de épocas
+    
+    // Parada temprana (desactivada con valores <= 0)
+    double error_objetivo = 0.0; // Detener al alcanzar este error por época
+    int paciencia = 0;           // Épocas sin mejora antes de detener
+    double mejora_minima = 1e-6; // Mejora mínima que reinicia la paciencia
+    
+    bool mostrar_progreso = true;
+};
+
+struct ResultadoEntrenamiento {
+    int epocas = 0;              // Épocas ejecutadas en esta llamada
+    int epoca_objetivo = -1;     // Primera época con error <= error_objetivo
+    double error_final = 0.0;
+    double segundos = 0.0;
+    bool parada_temprana = false;
+    bool interrumpido = false;   // El recorrido falló: la época no cuenta
+};
+
+string nombre_optimizador(TipoOptimizador tipo);
+string nombre_calendario(TipoCalendario tipo);
+
+// Nombres de la línea de comandos (sgd, momentum, adam / constante,
+// escalonada, exponencial, coseno); false e informe si no se reconoce
+bool interpretar_optimizador(const string& texto, TipoOptimizador& tipo);
+bool interpretar_calendario(const string& texto, TipoCalendario& tipo);
+
+// Comprueba que los valores de la configuración tengan sentido (tasa > 0,
+// paso del calendario >= 1, betas en [0, 1), ...); informa el primero que no
+bool validar_config(const ConfigEntrenamiento& config);
+
+double tasa_segun_calendario(const ConfigEntrenamiento& config, int epoca);
+
+// ==================== CLASE: RED NEURONAL ====================
+class RedNeuronal {
+private:
+    // Topología
+    int entradas;
+    int neuronas_oculta;
+    int salidas;
+    
+    // Todos los parámetros viven en un único bloque contiguo:
+    // propio (parametros) o el de un checkpoint mapeado (modelo_mapeado)
+    vector<double> parametros;
+    ArchivoMapeado modelo_mapeado;
+    
+    // Pesos de las conexiones entre capas (vistas sobre el bloque)
+    double* pesos_entrada_oculta;   // [entradas][neuronas_oculta]
+    double* pesos_oculta_salida;    // [neuronas_oculta][salidas]
+    
+    // Sesgos (bias) de cada capa
+    double* sesgo_oculta;   // [neuronas_oculta]
+    double* sesgo_salida;   // [salidas]
+    
+    // Activaciones de cada capa (valores de las neuronas)
+    vector<double> activacion_entrada;   // [entradas]
+    vector<double> activacion_oculta;    // [neuronas_oculta]
+    vector<double> activacion_salida;    // [salidas]
+    
+    // Entrada binaria: índices de los píxeles encendidos, en orden creciente
+    vector<int> entradas_activas;
+    
+    // Errores de la retropropagación en curso
+    vector<double> error_salida;         // [salidas]
+    vector<double> error_oculta;         // [neuronas_oculta]
+    
+    // Estado del entrenamiento (se guarda en el checkpoint)
+    ConfigEntrenamiento config;
+    double tasa_actual;              // Tasa de la época en curso (calendario)
+    int epoca_actual;
+    bool finalizado;
+    double mejor_error;              // Paciencia: mejor error por época hasta ahora
+    int epocas_sin_mejora;
+    unsigned semilla_aumento;        // Aumento de datos: semilla del flujo de variantes
+    uint64_t variantes_consumidas;   // y variantes ya entrenadas (0 sin aumento)
+    
+    // Estado del optimizador, indexado como el bloque de parámetros
+    vector<double> estado_1;         // Momentum: velocidad. Adam: media de gradientes
+    vector<double> estado_2;         // Adam: media de gradientes al cuadrado
+    uint64_t pasos_optimizador;
+    double correccion_1;             // Adam: 1 / (1 - beta1^t)
+    double correccion_2;             // Adam: 1 / (1 - beta2^t)
+    
+    // Generador de números aleatorios
+    mt19937 generador;
+    
+    size_t num_parametros() const {
+        return static_cast<size_t>(entradas) * neuronas_oculta
+             + static_cast<size_t>(neuronas_oculta) * salidas
+             + neuronas_oculta + salidas;
+    }
+    
+    // Reparte el bloque de parámetros entre pesos y sesgos
+    void asignar_vistas(double* bloque) {
+        pesos_entrada_oculta = bloque;
+        pesos_oculta_salida = pesos_entrada_oculta + entradas * neuronas_oculta;
+        sesgo_oculta = pesos_oculta_salida + neuronas_oculta * salidas;
+        sesgo_salida = sesgo_oculta + neuronas_oculta;
+    }
+    
+    // Copia los parámetros mapeados a memoria propia y libera el mapeo
+    void materializar() {
+        if (!modelo_mapeado.esta_abierto()) return;
+        vector<double> copia(pesos_entrada_oculta, pesos_entrada_oculta + num_parametros());
+        parametros.swap(copia);
+        asignar_vistas(parametros.data());
+        modelo_mapeado.cerrar();
+    }
+    
+    // Dimensiona el estado del optimizador (vacío para SGD)
+    void preparar_optimizador() {
+        size_t n = num_parametros();
+        estado_1.assign(config.optimizador == OPT_SGD ? 0 : n, 0.0);
+        estado_2.assign(config.optimizador == OPT_ADAM ? n : 0, 0.0);
+        pasos_optimizador = 0;
+    }
+    
+    // Aplica el paso del optimizador al parámetro 'indice' del bloque.
+    // 'error * activacion' es el gradiente negativo del error cuadrático.
+    // El optimizador es parámetro de plantilla para no decidirlo por peso.
+    template <TipoOptimizador OPTIMIZADOR>
+    inline void ajustar(size_t indice, double error, double activacion) {
+        double* parametro = pesos_entrada_oculta + indice;
+        if (OPTIMIZADOR == OPT_SGD) {
+            *parametro += tasa_actual * error * activacion;
+        } else if (OPTIMIZADOR == OPT_MOMENTUM) {
+            estado_1[indice] = config.momento * estado_1[indice] + error * activacion;
+            *parametro += tasa_actual * estado_1[indice];
+        } else {
+            double g = error * activacion;
+            estado_1[indice] = config.beta1 * estado_1[indice] + (1.0 - config.beta1) * g;
+            estado_2[indice] = config.beta2 * estado_2[indice] + (1.0 - config.beta2) * g * g;
+            double m = estado_1[indice] * correccion_1;
+            double v = estado_2[indice] * correccion_2;
+            *parametro += tasa_actual * m / (sqrt(v) + config.epsilon);
+        }
+    }
+    
+    template <TipoOptimizador OPTIMIZADOR>
+    void actualizar_parametros() {
+        const size_t inicio_oculta_salida = static_cast<size_t>(entradas) * neuronas_oculta;
+        const size_t inicio_sesgo_oculta = inicio_oculta_salida + static_cast<size_t>(neuronas_oculta) * salidas;
+        const size_t inicio_sesgo_salida = inicio_sesgo_oculta + neuronas_oculta;
+        
+        // Actualizar pesos entre capa oculta y salida
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            for (int k = 0; k < salidas; ++k) {
+                ajustar<OPTIMIZADOR>(inicio_oculta_salida + j * salidas + k, error_salida[k], activacion_oculta[j]);
+            }
+        }
+        
+        // Actualizar pesos entre entrada y capa oculta
+        for (int i = 0; i < entradas; ++i) {
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                ajustar<OPTIMIZADOR>(static_cast<size_t>(i) * neuronas_oculta + j, error_oculta[j], activacion_entrada[i]);
+            }
+        }
+        
+        // Actualizar sesgos de la capa de salida
+        for (int k = 0; k < salidas; ++k) {
+            ajustar<OPTIMIZADOR>(inicio_sesgo_salida + k, error_salida[k], 1.0);
+        }
+        
+        // Actualizar sesgos de la capa oculta
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            ajustar<OPTIMIZADOR>(inicio_sesgo_oculta + j, error_oculta[j], 1.0);
+        }
+    }
+    
+    // Como actualizar_parametros<OPT_SGD>, pero de los pesos de entrada
+    // solo ajusta las filas de los píxeles encendidos: en los apagados el
+    // gradiente es exactamente 0 y SGD los deja igual. Momentum y Adam
+    // mueven el parámetro aunque el gradiente sea 0 (decae la velocidad o
+    // el momento), así que para ellos no hay atajo exacto.
+    void actualizar_parametros_bits_sgd() {
+        const size_t inicio_oculta_salida = static_cast<size_t>(entradas) * neuronas_oculta;
+        const size_t inicio_sesgo_oculta = inicio_oculta_salida + static_cast<size_t>(neuronas_oculta) * salidas;
+        const size_t inicio_sesgo_salida = inicio_sesgo_oculta + neuronas_oculta;
+        
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            for (int k = 0; k < salidas; ++k) {
+                ajustar<OPT_SGD>(inicio_oculta_salida + j * salidas + k, error_salida[k], activacion_oculta[j]);
+            }
+        }
+        for (int i : entradas_activas) {
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                ajustar<OPT_SGD>(static_cast<size_t>(i) * neuronas_oculta + j, error_oculta[j], 1.0);
+            }
+        }
+        for (int k = 0; k < salidas; ++k) {
+            ajustar<OPT_SGD>(inicio_sesgo_salida + k, error_salida[k], 1.0);
+        }
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            ajustar<OPT_SGD>(inicio_sesgo_oculta + j, error_oculta[j], 1.0);
+        }
+    }
+    
+    // Capa de salida a partir de activacion_oculta (común a las dos entradas)
+    void propagar_salida() {
+        for (int k = 0; k < salidas; ++k) {
+            double suma = sesgo_salida[k];
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                suma += activacion_oculta[j] * pesos_oculta_salida[j * salidas + k];
+            }
+            activacion_salida[k] = sigmoide(suma);
+        }
+    }
+    
+    // Errores de salida y de la capa oculta, y corrección de Adam del paso
+    void calcular_errores(const vector<double>& objetivo) {
+        for (int k = 0; k < salidas; ++k) {
+            double error = objetivo[k] - activacion_salida[k];
+            error_salida[k] = error * derivada_sigmoide(activacion_salida[k]);
+        }
+        
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            double error = 0.0;
+            for (int k = 0; k < salidas; ++k) {
+                error += error_salida[k] * pesos_oculta_salida[j * salidas + k];
+            }
+            error_oculta[j] = error * derivada_sigmoide(activacion_oculta[j]);
+        }
+        
+        ++pasos_optimizador;
+        if (config.optimizador == OPT_ADAM) {
+            correccion_1 = 1.0 / (1.0 - pow(config.beta1, static_cast<double>(pasos_optimizador)));
+            correccion_2 = 1.0 / (1.0 - pow(config.beta2, static_cast<double>(pasos_optimizador)));
+        }
+    }
+    
+    // Inicializa pesos con valores aleatorios pequeños
+    void inicializar_pesos() {
+        uniform_real_distribution<double> dist(-0.5, 0.5);
+        
+        parametros.assign(num_parametros(), 0.0);
+        asignar_vistas(parametros.data());
+        
+        // Inicializar pesos entre entrada y capa oculta
+        for (int i = 0; i < entradas; ++i) {
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                pesos_entrada_oculta[i * neuronas_oculta + j] = dist(generador);
+            }
+        }
+        
+        // Inicializar pesos entre capa oculta y salida
+        for (int i = 0; i < neuronas_oculta; ++i) {
+            for (int j = 0; j < salidas; ++j) {
+                pesos_oculta_salida[i * salidas + j] = dist(generador);
+            }
+        }
+        
+        // Inicializar sesgos
+        for (int i = 0; i < neuronas_oculta; ++i) {
+            sesgo_oculta[i] = dist(generador);
+        }
+        for (int i = 0; i < salidas; ++i) {
+            sesgo_salida[i] = dist(generador);
+        }
+    }
+
+public:
+    RedNeuronal(int num_entradas = ENTRADAS, int num_oculta = NEURONAS_OCULTA,
+                int num_salidas = SALIDAS, unsigned semilla = 42)  // Semilla fija para reproducibilidad
+        : entradas(num_entradas), neuronas_oculta(num_oculta), salidas(num_salidas),
+          tasa_actual(TASA_APRENDIZAJE), epoca_actual(0), finalizado(false),
+          mejor_error(numeric_limits<double>::infinity()), epocas_sin_mejora(0),
+          semilla_aumento(0), variantes_consumidas(0),
+          pasos_optimizador(0), correccion_1(1.0), correccion_2(1.0), generador(semilla) {
+        activacion_entrada.resize(entradas);
+        activacion_oculta.resize(neuronas_oculta);
+        activacion_salida.resize(salidas);
+        error_salida.resize(salidas);
+        error_oculta.resize(neuronas_oculta);
+        inicializar_pesos();
+    }
+    
+    // Las vistas apuntan al bloque propio o al mapeo: copiar la red las
+    // dejaría apuntando a otra instancia, así que solo se permite moverla
+    RedNeuronal(const RedNeuronal&) = delete;
+    RedNeuronal& operator=(const RedNeuronal&) = delete;
+    RedNeuronal(RedNeuronal&&) = default;
+    RedNeuronal& operator=(RedNeuronal&&) = default;
+    
+    // PROPAGACIÓN HACIA ADELANTE (Forward Propagation)
+    // Calcula la salida de la red dada una entrada
+    vector<double> forward(const vector<double>& entrada) {
+        // Copiar entrada a la capa de entrada
+        activacion_entrada = entrada;
+        
+        // Calcular activaciones de la capa oculta
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            double suma = sesgo_oculta[j];
+            for (int i = 0; i < entradas; ++i) {
+                suma += activacion_entrada[i] * pesos_entrada_oculta[i * neuronas_oculta + j];
+            }
+            activacion_oculta[j] = sigmoide(suma);
+        }
+        
+        // Calcular activaciones de la capa de salida
+        propagar_salida();
+        
+        return activacion_salida;
+    }
+    
+    // PROPAGACIÓN CON ENTRADA BINARIA
+    // La capa oculta es el sesgo más la suma de las filas de pesos de los
+    // píxeles encendidos. Las filas se suman en orden creciente de píxel,
+    // el mismo orden de forward(), y los términos omitidos son 0 * peso:
+    // el resultado es idéntico al de forward() con la entrada desempaquetada.
+    // La igualdad bit a bit (también la de actualizar_parametros_bits_sgd,
+    // que omite los productos por 1.0) requiere compilar sin contracción a
+    // FMA: red_neuronal exporta -ffp-contract=off y la comprueba
+    // pruebas/prueba_entrada_bits.cpp.
+    vector<double> forward_bits(const EntradaBits& entrada) {
+        entradas_activas.clear();
+        for (size_t w = 0; w < entrada.size(); ++w) {
+            uint64_t palabra = entrada[w];
+            while (palabra != 0) {
+                entradas_activas.push_back(static_cast<int>(w * 64) + __builtin_ctzll(palabra));
+                palabra &= palabra - 1;   // Apagar el bit menos significativo
+            }
+        }
+        
+        copy(sesgo_oculta, sesgo_oculta + neuronas_oculta, activacion_oculta.begin());
+        for (int i : entradas_activas) {
+            const double* fila = &pesos_entrada_oculta[i * neuronas_oculta];
+            for (int j = 0; j < neuronas_oculta; ++j) {
+                activacion_oculta[j] += fila[j];
+            }
+        }
+        for (int j = 0; j < neuronas_oculta; ++j) {
+            activacion_oculta[j] = sigmoide(activacion_oculta[j]);
+        }
+        
+        propagar_salida();
+        return activacion_salida;
+    }
+    
+    // RETROPROPAGACIÓN (Backpropagation)
+    // Ajusta los pesos de la red para minimizar el error
+    void backward(const vector<double>& objetivo) {
+        calcular_errores(objetivo);
+        INSTRUMENTAR_ETAPA("red.backward");
+        
+        switch (config.optimizador) {
+            case OPT_SGD: actualizar_parametros<OPT_SGD>(); break;
+            case OPT_MOMENTUM: actualizar_parametros<OPT_MOMENTUM>(); break;
+            case OPT_ADAM: actualizar_parametros<OPT_ADAM>(); break;
+        }
+        INSTRUMENTAR_ETAPA("red.actualizacion");
+    }
+    
+    // RETROPROPAGACIÓN TRAS forward_bits()
+    // Con SGD solo se actualizan las filas de los píxeles encendidos.
+    // Momentum y Adam reconstruyen la entrada densa y usan la
+    // actualización completa; el resultado coincide con backward().
+    void backward_bits(const vector<double>& objetivo) {
+        calcular_errores(objetivo);
+        INSTRUMENTAR_ETAPA("red.backward");
+        
+        if (config.optimizador == OPT_SGD) {
+            actualizar_parametros_bits_sgd();
+        } else {
+            fill(activacion_entrada.begin(), activacion_entrada.end(), 0.0);
+            for (int i : entradas_activas) activacion_entrada[i] = 1.0;
+            if (config.optimizador == OPT_MOMENTUM) actualizar_parametros<OPT_MOMENTUM>();
+            else actualizar_parametros<OPT_ADAM>();
+        }
+        INSTRUMENTAR_ETAPA("red.actualizacion");
+    }
+    
+    // Entrena la red hasta completar config.epocas o hasta que se cumpla un
+    // criterio de parada temprana. En cada época se llama a recorrer(f),
+    // que debe invocar f(entrada, objetivo) para cada patrón; así el mismo
+    // bucle sirve para datos en memoria y para datos leídos en flujo. La
+    // entrada puede ser vector<double> o EntradaBits (ruta binaria).
+    // Si la red viene de un checkpoint, continúa desde la época guardada.
+    // Con archivo_checkpoint no vacío guarda el progreso cada 500 épocas.
+    // Si 'recorrer' devuelve bool, false interrumpe el entrenamiento.
+    template <typename Recorrido>
+    ResultadoEntrenamiento entrenar_recorrido(Recorrido recorrer, const string& archivo_checkpoint = "") {
+        ResultadoEntrenamiento resultado;
+        if (config.mostrar_progreso) {
+            cout << "\nEntrenando la red neuronal (" << nombre_optimizador(config.optimizador) << ")...\n";
+            if (epoca_actual > 0) {
+                cout << "Reanudando desde la época " << epoca_actual << "\n";
+            }
+        }
+        
+        auto inicio = chrono::high_resolution_clock::now();
+        
+        while (epoca_actual < config.epocas && !finalizado) {
+            INSTRUMENTAR_AMBITO("red.epoca");
+            double error_total = 0.0;
+            tasa_actual = tasa_segun_calendario(config, epoca_actual);
+            
+            // Entrenar con cada patrón
+            auto entrenar_patron = [&](const auto& entrada, const vector<double>& objetivo) {
+                INSTRUMENTAR_INICIO_ETAPAS();
+                constexpr bool binaria = is_same<decay_t<decltype(entrada)>, EntradaBits>::value;
+                if constexpr (binaria) forward_bits(entrada);
+                else forward(entrada);
+                INSTRUMENTAR_ETAPA("red.forward");
+                
+                // Calcular error cuadrático medio (antes de que backward
+                // cambie los pesos, sobre la salida de este patrón)
+                for (int k = 0; k < salidas; ++k) {
+                    double diff = objetivo[k] - activacion_salida[k];
+                    error_total += diff * diff;
+                }
+                
+                if constexpr (binaria) backward_bits(objetivo);
+                else backward(objetivo);
+            };
+            // Un recorrido que devuelve false no entregó todos los patrones
+            // (p. ej. falló la lectura del archivo): se detiene sin contar
+            // la época ni guardar el checkpoint
+            if constexpr (is_same<decltype(recorrer(entrenar_patron)), bool>::value) {
+                if (!recorrer(entrenar_patron)) {
+                    resultado.interrumpido = true;
+                    break;
+                }
+            } else {
+                recorrer(entrenar_patron);
+            }
+            ++epoca_actual;
+            ++resultado.epocas;
+            resultado.error_final = error_total;
+            
+            // Criterios de parada temprana
+            if (config.error_objetivo > 0.0 && error_total <= config.error_objetivo) {
+                resultado.epoca_objetivo = epoca_actual;
+                resultado.parada_temprana = epoca_actual < config.epocas;
+                finalizado = true;
+            }
+            if (config.paciencia > 0) {
+                if (error_total < mejor_error - config.mejora_minima) {
+                    mejor_error = error_total;
+                    epocas_sin_mejora = 0;
+                } else if (++epocas_sin_mejora >= config.paciencia) {
+                    resultado.parada_temprana = true;
+                    finalizado = true;
+                }
+            }
+            
+            // Mostrar progreso (y guardar checkpoint) cada 500 épocas
+            if (epoca_actual % 500 == 0 || finalizado) {
+                if (config.mostrar_progreso) {
+                    cout << "Época " << epoca_actual << "/" << config.epocas 
+                         << " - Error: " << fixed << setprecision(6) << error_total << endl;
+                }
+                
+                if (!archivo_checkpoint.empty()) {
+                    guardar(archivo_checkpoint);
+                }
+            }
+        }
+        
+        auto fin = chrono::high_resolution_clock::now();
+        resultado.segundos = chrono::duration<double>(fin - inicio).count();
+        if (resultado.interrumpido) return resultado;
+        finalizado = true;
+        
+        if (config.mostrar_progreso) {
+            if (resultado.parada_temprana) {
+                cout << "Parada temprana en la época " << epoca_actual << "\n";
+            }
+            cout << "¡Entrenamiento completado!\n\n";
+        }
+        return resultado;
+    }
+    
+    // Entrena la red con un conjunto de datos en memoria. Si todas las
+    // entradas son 0/1 se empaquetan y se entrena por la ruta binaria, con
+    // el mismo resultado que la densa.
+    ResultadoEntrenamiento entrenar(const vector<vector<double>>& datos, const vector<vector<double>>& objetivos,
+                                    const string& archivo_checkpoint = "") {
+        if (es_entrada_binaria(datos)) {
+            vector<EntradaBits> datos_bits;
+            datos_bits.reserve(datos.size());
+            for (const vector<double>& entrada : datos) datos_bits.push_back(empaquetar_entrada(entrada));
+            return entrenar_bits(datos_bits, objetivos, archivo_checkpoint);
+        }
+        return entrenar_densa(datos, objetivos, archivo_checkpoint);
+    }
+    
+    // Ruta densa explícita (entradas con cualquier valor)
+    ResultadoEntrenamiento entrenar_densa(const vector<vector<double>>& datos, const vector<vector<double>>& objetivos,
+                                          const string& archivo_checkpoint = "") {
+        return entrenar_recorrido([&](auto&& entrenar_patron) {
+            for (size_t i = 0; i < datos.size(); ++i) {
+                entrenar_patron(datos[i], objetivos[i]);
+            }
+        }, archivo_checkpoint);
+    }
+    
+    ResultadoEntrenamiento entrenar_bits(const vector<EntradaBits>& datos, const vector<vector<double>>& objetivos,
+                                         const string& archivo_checkpoint = "") {
+        return entrenar_recorrido([&](auto&& entrenar_patron) {
+            for (size_t i = 0; i < datos.size(); ++i) {
+                entrenar_patron(datos[i], objetivos[i]);
+            }
+        }, archivo_checkpoint);
+    }
+    
+    // Predice la clase de un patrón de entrada
+    vector<double> predecir(const vector<double>& entrada) {
+        return forward(entrada);
+    }
+    
+    // ==================== PERSISTENCIA ====================
+    // Guarda topología, parámetros, época, tasa de aprendizaje, estado del
+    // optimizador y estado del RNG
+    bool guardar(const string& nombre_archivo);
+    
+    // Carga un checkpoint mapeando el archivo: los pesos se usan en el lugar,
+    // sin copiarlos. La topología de la red pasa a ser la del archivo.
+    bool cargar(const string& nombre_archivo);
+    
+    // Acceso de solo lectura a los parámetros entrenados (bloques contiguos)
+    const double* obtener_pesos_entrada_oculta() const { return pesos_entrada_oculta; }   // [entradas][neuronas_oculta]
+    const double* obtener_pesos_oculta_salida() const { return pesos_oculta_salida; }     // [neuronas_oculta][salidas]
+    const double* obtener_sesgo_oculta() const { return sesgo_oculta; }
+    const double* obtener_sesgo_salida() const { return sesgo_salida; }
+    
+    int obtener_entradas() const { return entradas; }
+    int obtener_neuronas_oculta() const { return neuronas_oculta; }
+    int obtener_salidas() const { return salidas; }
+    int obtener_epoca() const { return epoca_actual; }
+    
+    // Posición en el flujo del aumento de datos (ver entrenar_con_aumento)
+    unsigned obtener_semilla_aumento() const { return semilla_aumento; }
+    uint64_t obtener_variantes_consumidas() const { return variantes_consumidas; }
+    void registrar_aumento(unsigned semilla, uint64_t consumidas) {
+        semilla_aumento = semilla;
+        variantes_consumidas = consumidas;
+    }
+    bool entrenamiento_finalizado() const { return finalizado; }
+    
+    // Cambia la configuración del entrenamiento. Si cambia el optimizador,
+    // su estado se reinicia. Devuelve false (sin cambiar nada) si la
+    // configuración no es válida.
+    bool configurar(const ConfigEntrenamiento& nueva) {
+        if (!validar_config(nueva)) return false;
+        size_t n = num_parametros();
+        bool reiniciar_estado = nueva.optimizador != config.optimizador
+                             || estado_1.size() != (nueva.optimizador == OPT_SGD ? 0 : n)
+                             || estado_2.size() != (nueva.optimizador == OPT_ADAM ? n : 0);
+        config = nueva;
+        tasa_actual = config.tasa_aprendizaje;
+        if (reiniciar_estado) preparar_optimizador();
+        if (epoca_actual < config.epocas) finalizado = false;
+        return true;
+    }
+    
+    const ConfigEntrenamiento& obtener_config() const { return config; }
+};
+
+#endif
@@ -0,0 +1,361 @@
+#include "servicio.h"
+
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <atomic>
+#include <iterator>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+class ServicioInferencia {
+private:
+    using Reloj = chrono::steady_clock;
+    
+    struct Solicitud {
+        uint64_t id;
+        vector<double> glifo;
+        Reloj::time_point llegada;
+    };
+    
+    ConfigServicio config;
+    string archivo_modelo;
+    FILE* salida;
+    bool vaciar_por_lote;        // Socket: cada lote se envía en cuanto se escribe
+    atomic<bool> salida_cerrada; // Falló una escritura (el cliente se fue): se descarta el resto
+    
+    // Una red por hilo de trabajo, cargadas una sola vez antes de atender
+    vector<RedNeuronal> redes;
+    
+    // Glifos leídos a la espera de formar lote
+    deque<Solicitud> pendientes;
+    bool fin_entrada;
+    mutex candado_pendientes;
+    condition_variable aviso_pendientes;
+    
+    // Lotes listos para los hilos de trabajo (acotada para dar contrapresión)
+    queue<vector<Solicitud>> lotes;
+    bool sin_mas_lotes;
+    mutex candado_lotes;
+    condition_variable aviso_lotes;
+    
+    // Resultados, contadores y lote adaptativo
+    mutex candado_resultados;
+    HistogramaLatencia latencias;
+    uint64_t glifos_procesados;
+    uint64_t lotes_procesados;
+    
+    // Escritos por los hilos de trabajo, leídos por el lector y el agrupador
+    atomic<double> costo_por_glifo_ns;   // Media exponencial del costo de clasificar un glifo
+    atomic<size_t> lote_objetivo;
+    
+    // Hilo lector: parsea glifos uno a uno para no esperar a llenar un bloque.
+    // La latencia de cada glifo se mide desde que entra en la cola del
+    // agrupador: una lectura de 1 MiB trae miles de glifos a la vez y su
+    // hora no dice cuándo pudo empezar a atenderse cada uno. La cola de
+    // pendientes está acotada a unos pocos lotes: si la entrada llega más
+    // rápido de lo que se clasifica, el lector espera en lugar de acumular
+    // latencia en la cola.
+    void leer(LectorGlifos* lector) {
+        BloqueDatos bloque;
+        uint64_t id = 0;
+        while (!salida_cerrada && lector->leer_bloque(bloque, 1)) {
+            unique_lock<mutex> lock(candado_pendientes);
+            aviso_pendientes.wait(lock, [&] {
+                return pendientes.size() < 2 * lote_objetivo.load() * static_cast<size_t>(config.hilos);
+            });
+            pendientes.push_back({id++, bloque.glifos[0], Reloj::now()});
+            aviso_pendientes.notify_all();
+        }
+        lock_guard<mutex> lock(candado_pendientes);
+        fin_entrada = true;
+        aviso_pendientes.notify_all();
+    }
+    
+    // Forma lotes: despacha cuando hay lote_objetivo glifos o cuando el más
+    // antiguo ya no puede esperar más sin pasarse del plazo
+    void agrupar() {
+        const auto plazo = chrono::duration_cast<Reloj::duration>(chrono::duration<double, milli>(config.plazo_ms));
+        unique_lock<mutex> lock(candado_pendientes);
+        while (true) {
+            if (pendientes.empty()) {
+                if (fin_entrada) break;
+                aviso_pendientes.wait(lock);
+                continue;
+            }
+            
+            size_t objetivo = lote_objetivo.load();
+            double costo_ns = costo_por_glifo_ns.load();
+            auto costo_lote = chrono::duration_cast<Reloj::duration>(
+                chrono::duration<double, nano>(costo_ns * objetivo));
+            auto limite = pendientes.front().llegada + plazo - costo_lote;
+            
+            if (pendientes.size() < objetivo && !fin_entrada && Reloj::now() < limite) {
+                aviso_pendientes.wait_until(lock, limite);
+                continue;
+            }
+            
+            size_t n = min(pendientes.size(), objetivo);
+            vector<Solicitud> lote(make_move_iterator(pendientes.begin()),
+                                   make_move_iterator(pendientes.begin() + static_cast<ptrdiff_t>(n)));
+            pendientes.erase(pendientes.begin(), pendientes.begin() + static_cast<ptrdiff_t>(n));
+            aviso_pendientes.notify_all();   // Hay espacio para el lector
+            
+            lock.unlock();
+            {
+                unique_lock<mutex> lock_lotes(candado_lotes);
+                aviso_lotes.wait(lock_lotes, [this] { return lotes.size() < static_cast<size_t>(2 * config.hilos); });
+                lotes.push(move(lote));
+            }
+            aviso_lotes.notify_all();
+            lock.lock();
+        }
+        
+        lock_guard<mutex> lock_lotes(candado_lotes);
+        sin_mas_lotes = true;
+        aviso_lotes.notify_all();
+    }
+    
+    void trabajar(size_t indice) {
+        RedNeuronal& red = redes[indice];
+        string texto;
+        
+        while (true) {
+            vector<Solicitud> lote;
+            {
+                unique_lock<mutex> lock(candado_lotes);
+                aviso_lotes.wait(lock, [this] { return !lotes.empty() || sin_mas_lotes; });
+                if (lotes.empty()) break;
+                lote = move(lotes.front());
+                lotes.pop();
+            }
+            aviso_lotes.notify_all();
+            
+            auto inicio = Reloj::now();
+            texto.clear();
+            char linea[64];
+            for (const Solicitud& s : lote) {
+                vector<double> puntajes = red.predecir(s.glifo);
+                unsigned mascara = 0;
+                for (int clase : interpretar_salida(puntajes, 0.5)) mascara |= 1u << clase;
+                
+                snprintf(linea, sizeof(linea), "%llu %x", static_cast<unsigned long long>(s.id), mascara);
+                texto += linea;
+                for (double p : puntajes) {
+                    snprintf(linea, sizeof(linea), " %.3f", p);
+                    texto += linea;
+                }
+                texto += '\n';
+            }
+            auto fin = Reloj::now();
+            
+            // Si el destino falla (cliente desconectado) se descarta el
+            // resto de su salida; el lector deja de leer y el servicio
+            // vuelve a accept()
+            lock_guard<mutex> lock(candado_resultados);
+            if (salida_cerrada) continue;
+            if (fwrite(texto.data(), 1, texto.size(), salida) != texto.size()
+                || (vaciar_por_lote && fflush(salida) != 0)) {
+                salida_cerrada = true;
+                continue;
+            }
+            auto escrito = Reloj::now();
+            
+            for (const Solicitud& s : lote) {
+                latencias.registrar(static_cast<uint64_t>(
+                    chrono::duration_cast<chrono::nanoseconds>(escrito - s.llegada).count()));
+            }
+            glifos_procesados += lote.size();
+            lotes_procesados++;
+            
+            // Ajuste adaptativo (aumento aditivo / reducción multiplicativa).
+            // Se reduce si el propio lote tardó más que el plazo, o si el
+            // glifo más antiguo lo superó sin que haya cola: entonces la
+            // espera vino de agrupar. Con cola, la espera es falta de
+            // throughput y un lote menor solo la alarga, así que se aumenta.
+            double costo = chrono::duration<double, nano>(fin - inicio).count() / lote.size();
+            costo_por_glifo_ns = 0.9 * costo_por_glifo_ns.load() + 0.1 * costo;
+            double servicio_ms = chrono::duration<double, milli>(escrito - inicio).count();
+            double peor_ms = chrono::duration<double, milli>(escrito - lote.front().llegada).count();
+            size_t objetivo = lote_objetivo.load();
+            bool hay_cola;
+            {
+                lock_guard<mutex> lock_pendientes(candado_pendientes);
+                hay_cola = pendientes.size() >= objetivo;
+            }
+            if (servicio_ms > config.plazo_ms || (peor_ms > config.plazo_ms && !hay_cola)) {
+                lote_objetivo = max<size_t>(1, objetivo / 2);
+            } else if (hay_cola || peor_ms < 0.5 * config.plazo_ms) {
+                lote_objetivo = min(config.lote_maximo, objetivo + 8);
+            }
+        }
+    }
+    
+    void reportar(const string& origen, double segundos) {
+        lock_guard<mutex> lock(candado_resultados);
+        cerr << "\n[servicio] " << origen << ": " << glifos_procesados << " glifos en "
+             << lotes_procesados << " lotes ("
+             << fixed << setprecision(1)
+             << (lotes_procesados ? static_cast<double>(glifos_procesados) / lotes_procesados : 0.0)
+             << " glifos/lote)\n";
+        cerr << "[servicio] Throughput: " << setprecision(0)
+             << (segundos > 0 ? glifos_procesados / segundos : 0.0) << " glifos/s en "
+             << setprecision(3) << segundos << " s\n";
+        cerr << "[servicio] Latencia (us): p50 " << setprecision(1) << latencias.percentil(50) / 1000.0
+             << "  p90 " << latencias.percentil(90) / 1000.0
+             << "  p99 " << latencias.percentil(99) / 1000.0
+             << "  p99.9 " << latencias.percentil(99.9) / 1000.0
+             << "  máx " << latencias.obtener_maximo() / 1000.0 << "\n";
+        cerr << "[servicio] Lote objetivo final: " << lote_objetivo.load()
+             << " (plazo " << config.plazo_ms << " ms)\n";
+        if (salida_cerrada) cerr << "[servicio] El destino se cerró: se descartó el resto de la salida\n";
+    }
+
+public:
+    ServicioInferencia(const ConfigServicio& configuracion, const string& modelo)
+        : config(configuracion), archivo_modelo(modelo), salida(stdout), vaciar_por_lote(false),
+          salida_cerrada(false), fin_entrada(false),
+          sin_mas_lotes(false), glifos_procesados(0), lotes_procesados(0),
+          costo_por_glifo_ns(0.0), lote_objetivo(1) {
+        if (config.hilos <= 0) config.hilos = max(1u, thread::hardware_concurrency());
+        if (config.lote_maximo == 0) config.lote_maximo = 1;
+    }
+    
+    // Carga la red de cada hilo de trabajo. Falla (con mensaje) si el
+    // checkpoint no existe o el entrenamiento no terminó.
+    bool cargar_redes() {
+        redes.clear();
+        for (int h = 0; h < config.hilos; ++h) {
+            redes.emplace_back();
+            if (!redes.back().cargar(archivo_modelo) || !redes.back().entrenamiento_finalizado()) {
+                cerr << "Error: Se requiere un modelo entrenado en " << archivo_modelo
+                     << " (ejecute primero el programa sin argumentos)\n";
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    // Atiende un flujo completo; 'lector' y 'destino' pertenecen al llamador
+    void atender(LectorGlifos* lector, FILE* destino, bool es_socket, const string& origen) {
+        salida = destino;
+        vaciar_por_lote = es_socket;
+        salida_cerrada = false;
+        pendientes.clear();
+        fin_entrada = false;
+        sin_mas_lotes = false;
+        latencias = HistogramaLatencia();
+        glifos_procesados = lotes_procesados = 0;
+        lote_objetivo = 1;
+        
+        auto inicio = Reloj::now();
+        vector<thread> trabajadores;
+        for (size_t h = 0; h < redes.size(); ++h) {
+            trabajadores.emplace_back(&ServicioInferencia::trabajar, this, h);
+        }
+        thread lector_hilo(&ServicioInferencia::leer, this, lector);
+        
+        agrupar();
+        
+        lector_hilo.join();
+        for (thread& t : trabajadores) t.join();
+        fflush(salida);
+        
+        reportar(origen, chrono::duration<double>(Reloj::now() - inicio).count());
+    }
+    
+    int ejecutar() {
+        if (!cargar_redes()) return 1;
+#ifndef _WIN32
+        // Escribir a un socket o tubería cerrados no debe terminar el
+        // proceso: fwrite devuelve el error y se atiende al siguiente cliente
+        signal(SIGPIPE, SIG_IGN);
+#endif
+        
+        const string prefijo_socket = "unix:";
+        if (config.entrada.compare(0, prefijo_socket.size(), prefijo_socket) == 0) {
+            return escuchar_socket(config.entrada.substr(prefijo_socket.size()));
+        }
+        
+        unique_ptr<LectorGlifos> lector = abrir_lector_glifos(config.entrada);
+        if (!lector) return 1;
+        
+        FILE* destino = stdout;
+        if (!config.salida.empty()) {
+            destino = fopen(config.salida.c_str(), "w");
+            if (destino == nullptr) {
+                cerr << "Error: No se pudo crear el archivo " << config.salida << endl;
+                return 1;
+            }
+        }
+        atender(lector.get(), destino, false, config.entrada);
+        bool escrito = !salida_cerrada && fflush(destino) == 0;
+        if (destino != stdout && fclose(destino) != 0) escrito = false;
+        if (!escrito) {
+            cerr << "Error: No se pudieron escribir los resultados\n";
+            return 1;
+        }
+        return 0;
+    }
+    
+    // Servidor en un socket Unix: atiende conexiones una tras otra y devuelve
+    // los resultados por la misma conexión
+    int escuchar_socket(const string& ruta) {
+#ifdef _WIN32
+        cerr << "Error: Los sockets Unix no están disponibles en Windows (" << ruta << ")\n";
+        return 1;
+#else
+        int servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (servidor < 0) {
+            cerr << "Error: No se pudo crear el socket\n";
+            return 1;
+        }
+        sockaddr_un direccion = {};
+        direccion.sun_family = AF_UNIX;
+        if (ruta.size() >= sizeof(direccion.sun_path)) {
+            cerr << "Error: Ruta de socket demasiado larga: " << ruta << endl;
+            ::close(servidor);
+            return 1;
+        }
+        strncpy(direccion.sun_path, ruta.c_str(), sizeof(direccion.sun_path) - 1);
+        unlink(ruta.c_str());
+        if (bind(servidor, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) != 0
+            || listen(servidor, 8) != 0) {
+            cerr << "Error: No se pudo escuchar en " << ruta << endl;
+            ::close(servidor);
+            return 1;
+        }
+        cerr << "[servicio] Escuchando en " << ruta << "\n";
+        
+        while (true) {
+            int cliente = accept(servidor, nullptr, nullptr);
+            if (cliente < 0) continue;
+            
+            // La entrada se lee con read() sobre el descriptor (sin el buffer
+            // de stdio, que esperaría a llenarse); la respuesta usa otro
+            // descriptor del mismo socket y se vacía tras cada lote
+            FILE* respuesta = fdopen(dup(cliente), "wb");
+            if (respuesta == nullptr) {
+                ::close(cliente);
+                continue;
+            }
+            
+            unique_ptr<LectorGlifos> lector = crear_lector_glifos_descriptor(cliente, ruta);
+            if (lector) {
+                atender(lector.get(), respuesta, true, ruta);
+            }
+            fclose(respuesta);
+        }
+#endif
+    }
+};
+
+int ejecutar_servicio_inferencia(const ConfigServicio& config, const string& archivo_modelo) {
+    ServicioInferencia servicio(config, archivo_modelo);
+    return servicio.ejecutar();
+}
@@ -0,0 +1,82 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - SERVICIO DE INFERENCIA
+// ============================================================================
+
+#ifndef SERVICIO_H
+#define SERVICIO_H
+
+#include "datos.h"
+
+using namespace std;
+
+// ==================== SERVICIO DE INFERENCIA POR LOTES ====================
+// Modo sin interfaz: lee un flujo de glifos (archivo o socket Unix), los
+// agrupa en micro-lotes y los clasifica en un grupo de hilos. Cada hilo
+// tiene su propia RedNeuronal cargada del checkpoint; como la carga mapea
+// el archivo, todos comparten las mismas páginas de pesos.
+//
+// Formato de salida, una línea por glifo:
+//   <id> <máscara de clases en hex> <puntaje_0> ... <puntaje_n>
+// Las líneas se escriben en orden de finalización (el id permite reordenar).
+
+struct ConfigServicio {
+    string entrada;              // Archivo de glifos o "unix:/ruta/al/socket"
+    string salida;               // Archivo de resultados; vacío = salida estándar
+    int hilos = 0;               // 0 = hardware_concurrency()
+    double plazo_ms = 5.0;       // Latencia objetivo por glifo
+    size_t lote_maximo = 256;
+};
+
+// Histograma de latencias con cubetas logarítmicas (64 subcubetas por
+// potencia de 2, error relativo < 2%): memoria constante en servicio continuo
+class HistogramaLatencia {
+private:
+    static const int SUBCUBETAS = 64;
+    vector<uint64_t> cubetas;
+    uint64_t total;
+    uint64_t maximo;
+    
+    static size_t indice(uint64_t ns) {
+        if (ns < SUBCUBETAS) return static_cast<size_t>(ns);
+        int bit_alto = 63 - __builtin_clzll(ns);
+        int desplazamiento = bit_alto - 6;   // log2(SUBCUBETAS) = 6
+        return static_cast<size_t>((desplazamiento + 1) * SUBCUBETAS + ((ns >> desplazamiento) - SUBCUBETAS));
+    }
+    
+    static uint64_t valor_representativo(size_t i) {
+        if (i < SUBCUBETAS) return i;
+        int desplazamiento = static_cast<int>(i / SUBCUBETAS) - 1;
+        uint64_t base = (SUBCUBETAS + i % SUBCUBETAS) << desplazamiento;
+        return base + ((uint64_t(1) << desplazamiento) >> 1);
+    }
+
+public:
+    HistogramaLatencia() : cubetas(SUBCUBETAS * 60, 0), total(0), maximo(0) {}
+    
+    void registrar(uint64_t ns) {
+        cubetas[min(indice(ns), cubetas.size() - 1)]++;
+        total++;
+        maximo = max(maximo, ns);
+    }
+    
+    // Percentil p ∈ [0, 100] en nanosegundos
+    uint64_t percentil(double p) const {
+        if (total == 0) return 0;
+        uint64_t objetivo = static_cast<uint64_t>(ceil(p / 100.0 * total));
+        uint64_t acumulado = 0;
+        for (size_t i = 0; i < cubetas.size(); ++i) {
+            acumulado += cubetas[i];
+            if (acumulado >= objetivo && acumulado > 0) return min(valor_representativo(i), maximo);
+        }
+        return maximo;
+    }
+    
+    uint64_t obtener_total() const { return total; }
+    uint64_t obtener_maximo() const { return maximo; }
+};
+
+// Atiende config.entrada con el modelo de 'archivo_modelo' hasta agotar la
+// entrada (o indefinidamente en un socket). Devuelve el código de salida.
+int ejecutar_servicio_inferencia(const ConfigServicio& config, const string& archivo_modelo);
+
+#endif
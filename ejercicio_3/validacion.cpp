@@ -0,0 +1,230 @@
+#include "validacion.h"
+
+#include <atomic>
+
+using namespace std;
+
+// ==================== DATOS ETIQUETADOS ====================
+bool cargar_glifos_etiquetados(const string& nombre_archivo, DatosEtiquetados& datos, size_t maximo) {
+    unique_ptr<LectorGlifos> lector = abrir_lector_glifos(nombre_archivo);
+    if (!lector) return false;
+
+    datos.glifos.clear();
+    datos.etiquetas.clear();
+    BloqueDatos bloque;
+    while (datos.glifos.size() < maximo
+           && lector->leer_bloque(bloque, min(GLIFOS_POR_BLOQUE, maximo - datos.glifos.size()))) {
+        for (size_t g = 0; g < bloque.cantidad; ++g) {
+            datos.glifos.push_back(bloque.glifos[g]);
+            datos.etiquetas.push_back(bloque.etiquetas[g] % 10);
+        }
+    }
+    return true;
+}
+
+// ==================== CONFIGURACIÓN ====================
+bool interpretar_busqueda(const string& texto, TipoBusqueda& tipo) {
+    if (texto == "rejilla" || texto == "grid") tipo = BUSQUEDA_REJILLA;
+    else if (texto == "aleatoria" || texto == "random") tipo = BUSQUEDA_ALEATORIA;
+    else {
+        cerr << "Error: Búsqueda desconocida: " << texto << " (rejilla o aleatoria)" << endl;
+        return false;
+    }
+    return true;
+}
+
+vector<Hiperparametros> generar_candidatos(const ConfigBusqueda& config) {
+    vector<Hiperparametros> candidatos;
+
+    if (config.tipo == BUSQUEDA_REJILLA) {
+        for (double n : config.neuronas_oculta) {
+            for (double t : config.tasas) {
+                for (double e : config.epocas) {
+                    for (double s : config.semillas) {
+                        Hiperparametros h;
+                        h.neuronas_oculta = static_cast<int>(n);
+                        h.tasa_aprendizaje = t;
+                        h.epocas = static_cast<int>(e);
+                        h.semilla = static_cast<unsigned>(s);
+                        candidatos.push_back(h);
+                    }
+                }
+            }
+        }
+        return candidatos;
+    }
+
+    // Aleatoria: enteros uniformes en [mín, máx], tasa log-uniforme (las
+    // tasas útiles abarcan varios órdenes de magnitud) y semilla de la lista
+    auto rango = [](const vector<double>& v) { return minmax_element(v.begin(), v.end()); };
+    auto neuronas = rango(config.neuronas_oculta);
+    auto tasas = rango(config.tasas);
+    auto epocas = rango(config.epocas);
+
+    mt19937 generador(config.semilla_particion);
+    uniform_int_distribution<int> dist_neuronas(static_cast<int>(*neuronas.first), static_cast<int>(*neuronas.second));
+    uniform_real_distribution<double> dist_log_tasa(log(*tasas.first), log(*tasas.second));
+    uniform_int_distribution<int> dist_epocas(static_cast<int>(*epocas.first), static_cast<int>(*epocas.second));
+    uniform_int_distribution<size_t> dist_semilla(0, config.semillas.size() - 1);
+
+    for (int m = 0; m < config.muestras; ++m) {
+        Hiperparametros h;
+        h.neuronas_oculta = dist_neuronas(generador);
+        h.tasa_aprendizaje = exp(dist_log_tasa(generador));
+        h.epocas = dist_epocas(generador);
+        h.semilla = static_cast<unsigned>(config.semillas[dist_semilla(generador)]);
+        candidatos.push_back(h);
+    }
+    return candidatos;
+}
+
+// ==================== VALIDACIÓN CRUZADA ====================
+Particion particionar(const DatosEtiquetados& datos, int pliegues, unsigned semilla) {
+    size_t n = datos.glifos.size();
+    vector<size_t> orden(n);
+    for (size_t i = 0; i < n; ++i) orden[i] = i;
+    mt19937 generador(semilla);
+    shuffle(orden.begin(), orden.end(), generador);
+
+    // Un solo contador recorre los glifos agrupados por dígito (en el orden
+    // barajado dentro de cada dígito): los pliegues difieren en a lo sumo
+    // un glifo en total y en cada dígito. Con un contador por dígito todos
+    // empezarían en el pliegue 0 y los primeros pliegues acumularían los
+    // restos de cada dígito.
+    vector<size_t> por_digito = orden;
+    stable_sort(por_digito.begin(), por_digito.end(),
+                [&](size_t a, size_t b) { return datos.etiquetas[a] < datos.etiquetas[b]; });
+    vector<int> pliegue(n);
+    for (size_t k = 0; k < n; ++k) pliegue[por_digito[k]] = static_cast<int>(k % pliegues);
+
+    Particion particion;
+    particion.entrenamiento.resize(pliegues);
+    particion.validacion.resize(pliegues);
+    for (size_t i : orden) {
+        for (int f = 0; f < pliegues; ++f) {
+            (f == pliegue[i] ? particion.validacion[f] : particion.entrenamiento[f]).push_back(i);
+        }
+    }
+    return particion;
+}
+
+namespace {
+
+struct ResultadoPliegue {
+    double precision_validacion = 0.0;
+    double precision_entrenamiento = 0.0;
+    double segundos = 0.0;
+};
+
+double precision(RedNeuronal& red, const DatosEtiquetados& datos, const vector<size_t>& indices,
+                 const vector<vector<int>>& clases_por_digito) {
+    if (indices.empty()) return 0.0;
+    size_t correctos = 0;
+    for (size_t i : indices) {
+        if (interpretar_salida(red.predecir(datos.glifos[i]), 0.5) == clases_por_digito[datos.etiquetas[i]]) {
+            correctos++;
+        }
+    }
+    return 100.0 * correctos / indices.size();
+}
+
+} // namespace
+
+// ==================== BÚSQUEDA EN PARALELO ====================
+ResultadoBusqueda buscar_hiperparametros(const DatosEtiquetados& datos, const ConfigBusqueda& config) {
+    INSTRUMENTAR_AMBITO("red.busqueda");
+
+    ResultadoBusqueda resultado;
+    vector<Hiperparametros> candidatos = generar_candidatos(config);
+    int pliegues = config.pliegues;
+    Particion particion = particionar(datos, pliegues, config.semilla_particion);
+
+    vector<vector<double>> objetivo_por_digito;
+    vector<vector<int>> clases_por_digito;
+    for (int d = 0; d < 10; ++d) {
+        clases_por_digito.push_back(obtener_clases(d));
+        objetivo_por_digito.push_back(clases_a_vector(clases_por_digito.back()));
+    }
+    int entradas = datos.glifos.empty() ? ENTRADAS : static_cast<int>(datos.glifos[0].size());
+
+    // Glifos 0/1: se entrena por la ruta binaria (mismo resultado, menos cómputo)
+    vector<EntradaBits> glifos_bits;
+    if (es_entrada_binaria(datos.glifos)) {
+        for (const vector<double>& g : datos.glifos) glifos_bits.push_back(empaquetar_entrada(g));
+    }
+
+    // Una tarea por (candidato, pliegue); cada una crea su propia red, así
+    // que los hilos no comparten estado mutable
+    resultado.entrenamientos = static_cast<int>(candidatos.size()) * pliegues;
+    int hilos = config.hilos > 0 ? config.hilos : static_cast<int>(max(1u, thread::hardware_concurrency()));
+    hilos = max(1, min(hilos, resultado.entrenamientos));
+    resultado.hilos = hilos;
+
+    vector<ResultadoPliegue> resultados(resultado.entrenamientos);
+    atomic<int> siguiente(0);
+    auto trabajar = [&]() {
+        for (int t = siguiente++; t < resultado.entrenamientos; t = siguiente++) {
+            const Hiperparametros& h = candidatos[t / pliegues];
+            int f = t % pliegues;
+
+            ConfigEntrenamiento entrenamiento = config.entrenamiento;
+            entrenamiento.tasa_aprendizaje = h.tasa_aprendizaje;
+            entrenamiento.epocas = h.epocas;
+            entrenamiento.mostrar_progreso = false;
+
+            RedNeuronal red(entradas, h.neuronas_oculta, SALIDAS, h.semilla);
+            red.configurar(entrenamiento);
+            const vector<size_t>& indices = particion.entrenamiento[f];
+            ResultadoEntrenamiento r = red.entrenar_recorrido([&](auto&& entrenar_patron) {
+                for (size_t i : indices) {
+                    if (!glifos_bits.empty()) entrenar_patron(glifos_bits[i], objetivo_por_digito[datos.etiquetas[i]]);
+                    else entrenar_patron(datos.glifos[i], objetivo_por_digito[datos.etiquetas[i]]);
+                }
+            });
+
+            resultados[t].segundos = r.segundos;
+            resultados[t].precision_entrenamiento = precision(red, datos, indices, clases_por_digito);
+            resultados[t].precision_validacion = precision(red, datos, particion.validacion[f], clases_por_digito);
+        }
+    };
+
+    auto inicio = chrono::high_resolution_clock::now();
+    vector<thread> trabajadores;
+    for (int h = 1; h < hilos; ++h) trabajadores.emplace_back(trabajar);
+    trabajar();
+    for (thread& t : trabajadores) t.join();
+    resultado.segundos = chrono::duration<double>(chrono::high_resolution_clock::now() - inicio).count();
+
+    // Media y desviación muestral entre pliegues de cada candidato. Un
+    // pliegue sin glifos de validación (más pliegues que glifos) no tiene
+    // precisión y no cuenta
+    int pliegues_validos = 0;
+    for (int f = 0; f < pliegues; ++f) pliegues_validos += particion.validacion[f].empty() ? 0 : 1;
+    for (size_t c = 0; c < candidatos.size(); ++c) {
+        ResultadoConfiguracion rc;
+        rc.parametros = candidatos[c];
+        for (int f = 0; f < pliegues; ++f) {
+            if (particion.validacion[f].empty()) continue;
+            const ResultadoPliegue& r = resultados[c * pliegues + f];
+            rc.media_validacion += r.precision_validacion / pliegues_validos;
+            rc.media_entrenamiento += r.precision_entrenamiento / pliegues_validos;
+            rc.segundos_entrenamiento += r.segundos / pliegues_validos;
+        }
+        double suma_cuadrados = 0.0;
+        for (int f = 0; f < pliegues; ++f) {
+            if (particion.validacion[f].empty()) continue;
+            double d = resultados[c * pliegues + f].precision_validacion - rc.media_validacion;
+            suma_cuadrados += d * d;
+        }
+        rc.desviacion_validacion = pliegues_validos > 1 ? sqrt(suma_cuadrados / (pliegues_validos - 1)) : 0.0;
+        resultado.configuraciones.push_back(rc);
+    }
+
+    // Mejor media primero; a igual media, menor dispersión
+    stable_sort(resultado.configuraciones.begin(), resultado.configuraciones.end(),
+                [](const ResultadoConfiguracion& a, const ResultadoConfiguracion& b) {
+                    if (a.media_validacion != b.media_validacion) return a.media_validacion > b.media_validacion;
+                    return a.desviacion_validacion < b.desviacion_validacion;
+                });
+    return resultado;
+}
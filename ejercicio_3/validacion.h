@@ -0,0 +1,93 @@
+// ============================================================================
+// RED NEURONAL ARTIFICIAL - VALIDACIÓN CRUZADA Y BÚSQUEDA DE HIPERPARÁMETROS
+// ============================================================================
+// Validación cruzada de k pliegues sobre un conjunto de glifos etiquetados
+// y búsqueda en rejilla o aleatoria sobre neuronas ocultas, tasa de
+// aprendizaje, épocas y semilla. Cada entrenamiento (configuración, pliegue)
+// es independiente y se ejecuta en un grupo de hilos, cada uno con su red.
+// ============================================================================
+
+#ifndef VALIDACION_H
+#define VALIDACION_H
+
+#include "datos.h"
+
+using namespace std;
+
+// ==================== DATOS ETIQUETADOS ====================
+struct DatosEtiquetados {
+    vector<vector<double>> glifos;
+    vector<int> etiquetas;   // Dígito 0-9 de cada glifo
+};
+
+// Carga todos los glifos del archivo (texto o binario) con su etiqueta
+bool cargar_glifos_etiquetados(const string& nombre_archivo, DatosEtiquetados& datos,
+                               size_t maximo = numeric_limits<size_t>::max());
+
+// ==================== CONFIGURACIÓN ====================
+enum TipoBusqueda {
+    BUSQUEDA_REJILLA,     // Producto cartesiano de las listas
+    BUSQUEDA_ALEATORIA    // Muestras dentro de los rangos [mín, máx] de cada lista
+};
+
+bool interpretar_busqueda(const string& texto, TipoBusqueda& tipo);
+
+struct Hiperparametros {
+    int neuronas_oculta = NEURONAS_OCULTA;
+    double tasa_aprendizaje = TASA_APRENDIZAJE;
+    int epocas = EPOCAS;
+    unsigned semilla = 42;
+};
+
+struct ConfigBusqueda {
+    vector<double> neuronas_oculta = {10, 20, 40};
+    vector<double> tasas = {0.05, 0.1, 0.2};
+    vector<double> epocas = {EPOCAS};
+    vector<double> semillas = {42};
+    TipoBusqueda tipo = BUSQUEDA_REJILLA;
+    int muestras = 20;                 // Configuraciones de la búsqueda aleatoria
+    int pliegues = 5;
+    unsigned semilla_particion = 2025; // Reparto en pliegues y muestreo aleatorio
+    int hilos = 0;                     // 0 = hardware_concurrency()
+    ConfigEntrenamiento entrenamiento; // Optimizador, calendario y parada de cada entrenamiento
+};
+
+// ==================== RESULTADOS ====================
+// Precisión = porcentaje de glifos cuyo conjunto de clases predicho
+// coincide exactamente con el esperado
+struct ResultadoConfiguracion {
+    Hiperparametros parametros;
+    double media_validacion = 0.0;
+    double desviacion_validacion = 0.0;   // Entre pliegues (muestral)
+    double media_entrenamiento = 0.0;     // Sobre los pliegues de entrenamiento
+    double segundos_entrenamiento = 0.0;  // Media por pliegue
+};
+
+struct ResultadoBusqueda {
+    vector<ResultadoConfiguracion> configuraciones;   // De mejor a peor
+    int entrenamientos = 0;
+    int hilos = 0;
+    double segundos = 0.0;                            // Tiempo de pared total
+};
+
+// Lista de configuraciones a evaluar según el tipo de búsqueda
+vector<Hiperparametros> generar_candidatos(const ConfigBusqueda& config);
+
+// ==================== PARTICIÓN EN PLIEGUES ====================
+struct Particion {
+    vector<vector<size_t>> entrenamiento;   // Por pliegue, en el orden barajado
+    vector<vector<size_t>> validacion;
+};
+
+// Baraja los índices con 'semilla' y los reparte estratificados por dígito:
+// el tamaño de validación de los pliegues difiere en a lo sumo uno, en total
+// y dentro de cada dígito. Con pliegues <= glifos ningún pliegue queda vacío.
+Particion particionar(const DatosEtiquetados& datos, int pliegues, unsigned semilla);
+
+// Evalúa cada candidato con validación cruzada de config.pliegues pliegues.
+// Los pliegues se estratifican por dígito y dependen solo de
+// semilla_particion, así que todos los candidatos ven la misma partición;
+// el resultado no depende del número de hilos.
+ResultadoBusqueda buscar_hiperparametros(const DatosEtiquetados& datos, const ConfigBusqueda& config);
+
+#endif